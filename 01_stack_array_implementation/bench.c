@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "stack.h"
+#include "concurrent_stack.h"
+
+#define TOTAL_PAIRS 4000000
+#define MAX_THREADS 16
+#define ITEMS_PER_THREAD 4
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+typedef enum { KIND_MUTEX, KIND_TREIBER, KIND_ELIMINATION } StackKind;
+
+static const char* kindNames[] = { "mutex", "treiber", "treiber + elimination" };
+
+// the way free lists are shared today: the plain Stack behind one mutex
+typedef struct {
+    pthread_mutex_t lock;
+    Stack* stack;
+} LockedStack;
+
+typedef struct {
+    StackKind kind;
+    LockedStack* locked;
+    ConcurrentStack* concurrent;
+    uint32_t pairs;
+    int64_t checksum;
+    pthread_t thread;
+} Worker;
+
+bool _push(Worker* worker, int32_t item) {
+    if (worker->kind != KIND_MUTEX) {
+        return ConcurrentPush(worker->concurrent, item);
+    }
+    pthread_mutex_lock(&worker->locked->lock);
+    bool pushed = Push(worker->locked->stack, item);
+    pthread_mutex_unlock(&worker->locked->lock);
+    return pushed;
+}
+
+bool _pop(Worker* worker, int32_t* item) {
+    if (worker->kind != KIND_MUTEX) {
+        return ConcurrentPop(worker->concurrent, item);
+    }
+    pthread_mutex_lock(&worker->locked->lock);
+    bool popped = Pop(worker->locked->stack, item);
+    pthread_mutex_unlock(&worker->locked->lock);
+    return popped;
+}
+
+// a thread takes a few items and gives them back, like a free list user
+void* _work(void* arg) {
+    Worker* worker = arg;
+    int32_t item;
+    uint32_t i, j;
+    for (i = 0; i < worker->pairs; i += ITEMS_PER_THREAD) {
+        for (j = 0; j < ITEMS_PER_THREAD; j++) {
+            _push(worker, (int32_t)(i + j));
+        }
+        for (j = 0; j < ITEMS_PER_THREAD; j++) {
+            if (_pop(worker, &item)) {
+                worker->checksum += item;
+            }
+        }
+    }
+    return NULL;
+}
+
+void _bench(StackKind kind, uint32_t threads) {
+    uint32_t capacity = threads * ITEMS_PER_THREAD;
+    LockedStack locked;
+    pthread_mutex_init(&locked.lock, NULL);
+    locked.stack = CreateNewStack(capacity);
+    ConcurrentStack* concurrent = CreateConcurrentStack(capacity,
+        kind == KIND_ELIMINATION ? (threads < ELIMINATION_MAX_SLOTS ? threads : ELIMINATION_MAX_SLOTS) : 0);
+    Worker workers[MAX_THREADS];
+    uint32_t i;
+    double start = _nowSeconds();
+    for (i = 0; i < threads; i++) {
+        workers[i].kind = kind;
+        workers[i].locked = &locked;
+        workers[i].concurrent = concurrent;
+        workers[i].pairs = TOTAL_PAIRS / threads;
+        workers[i].checksum = 0;
+        pthread_create(&workers[i].thread, NULL, _work, &workers[i]);
+    }
+    int64_t checksum = 0;
+    for (i = 0; i < threads; i++) {
+        pthread_join(workers[i].thread, NULL);
+        checksum += workers[i].checksum;
+    }
+    double elapsed = _nowSeconds() - start;
+    printf("  %-22s %2u threads   %7.2f M push/pop pairs/s   (checksum %lld)\n", kindNames[kind], threads,
+        (double)(TOTAL_PAIRS / threads * threads) / elapsed / 1e6, (long long)checksum);
+    DestroyConcurrentStack(&concurrent);
+    DestroyStack(&locked.stack);
+    pthread_mutex_destroy(&locked.lock);
+}
+
+int main(void) {
+    printf("%d push/pop pairs, %ld cores\n", TOTAL_PAIRS, sysconf(_SC_NPROCESSORS_ONLN));
+    uint32_t threads;
+    for (threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        _bench(KIND_MUTEX, threads);
+        _bench(KIND_TREIBER, threads);
+        _bench(KIND_ELIMINATION, threads);
+    }
+    return 0;
+}
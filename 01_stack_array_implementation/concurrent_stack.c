@@ -0,0 +1,167 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "concurrent_stack.h"
+
+ConcurrentStack* CreateConcurrentStack(uint32_t capacity, uint32_t eliminationSlots) {
+    if (capacity == 0 || capacity == CONCURRENT_STACK_NIL || eliminationSlots > ELIMINATION_MAX_SLOTS) {
+        return NULL;
+    }
+    ConcurrentStack* stack = aligned_alloc(CACHE_LINE_SIZE, sizeof(ConcurrentStack));
+    if (stack == NULL) {
+        return NULL;
+    }
+    stack->nodes = malloc(sizeof(StackNode) * capacity);
+    if (stack->nodes == NULL) {
+        free(stack);
+        return NULL;
+    }
+    // at first every node is in the free list, in order
+    uint32_t i;
+    for (i = 0; i < capacity; i++) {
+        atomic_init(&stack->nodes[i].next, i + 1 < capacity ? i + 1 : CONCURRENT_STACK_NIL);
+        stack->nodes[i].item = 0;
+    }
+    for (i = 0; i < ELIMINATION_MAX_SLOTS; i++) {
+        atomic_init(&stack->elimination[i].exchange, 0);
+    }
+    atomic_init(&stack->top, TAGGED(0, CONCURRENT_STACK_NIL));
+    atomic_init(&stack->free, TAGGED(0, 0));
+    stack->eliminationSlots = eliminationSlots;
+    stack->capacity = capacity;
+    return stack;
+}
+
+void DestroyConcurrentStack(ConcurrentStack** stackp) {
+    ConcurrentStack* stack = *stackp;
+    if (stack == NULL) {
+        return;
+    }
+    free(stack->nodes);
+    free(stack);
+    *stackp = NULL;
+}
+
+bool _tryPushNode(_Atomic uint64_t* top, StackNode* nodes, uint32_t index) {
+    uint64_t old = atomic_load_explicit(top, memory_order_relaxed);
+    atomic_store_explicit(&nodes[index].next, TAGGED_INDEX(old), memory_order_relaxed);
+    // release publishes the item and next to whoever pops the node
+    return atomic_compare_exchange_strong_explicit(top, &old, TAGGED(TAGGED_TAG(old) + 1, index),
+        memory_order_release, memory_order_relaxed);
+}
+
+uint32_t _tryPopNode(_Atomic uint64_t* top, StackNode* nodes, bool* lostRace) {
+    uint64_t old = atomic_load_explicit(top, memory_order_acquire);
+    uint32_t index = TAGGED_INDEX(old);
+    if (index == CONCURRENT_STACK_NIL) {
+        *lostRace = false;
+        return CONCURRENT_STACK_NIL;
+    }
+    // the node may be popped and reused before the swap below, then this
+    // next is stale, but the tag has changed too and the swap fails
+    uint32_t next = atomic_load_explicit(&nodes[index].next, memory_order_relaxed);
+    if (atomic_compare_exchange_strong_explicit(top, &old, TAGGED(TAGGED_TAG(old) + 1, next),
+        memory_order_acquire, memory_order_relaxed)) {
+        return index;
+    }
+    *lostRace = true;
+    return CONCURRENT_STACK_NIL;
+}
+
+uint32_t _pickEliminationSlot(ConcurrentStack* stack) {
+    // xorshift, one state per thread so picking a slot shares nothing
+    static _Thread_local uint32_t state = 0;
+    if (state == 0) {
+        state = (uint32_t)(uintptr_t)&state | 1;
+    }
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state % stack->eliminationSlots;
+}
+
+bool _offerToPop(ConcurrentStack* stack, uint32_t index) {
+    _Atomic uint64_t* exchange = &stack->elimination[_pickEliminationSlot(stack)].exchange;
+    uint64_t seen = atomic_load_explicit(exchange, memory_order_relaxed);
+    if (TAGGED_INDEX(seen) != 0) {
+        return false;
+    }
+    uint64_t offered = TAGGED(TAGGED_TAG(seen) + 1, index + 1);
+    if (!atomic_compare_exchange_strong_explicit(exchange, &seen, offered,
+        memory_order_release, memory_order_relaxed)) {
+        return false;
+    }
+    int i;
+    for (i = 0; i < ELIMINATION_SPINS; i++) {
+        if (atomic_load_explicit(exchange, memory_order_relaxed) != offered) {
+            break;
+        }
+    }
+    // a pop and the withdrawal race for the same swap, only one of them wins
+    if (atomic_compare_exchange_strong_explicit(exchange, &offered, TAGGED(TAGGED_TAG(offered) + 1, 0),
+        memory_order_relaxed, memory_order_relaxed)) {
+        return false;
+    }
+    return true;
+}
+
+uint32_t _takeFromPush(ConcurrentStack* stack) {
+    _Atomic uint64_t* exchange = &stack->elimination[_pickEliminationSlot(stack)].exchange;
+    uint64_t seen = atomic_load_explicit(exchange, memory_order_relaxed);
+    if (TAGGED_INDEX(seen) == 0) {
+        return CONCURRENT_STACK_NIL;
+    }
+    if (atomic_compare_exchange_strong_explicit(exchange, &seen, TAGGED(TAGGED_TAG(seen) + 1, 0),
+        memory_order_acquire, memory_order_relaxed)) {
+        return TAGGED_INDEX(seen) - 1;
+    }
+    return CONCURRENT_STACK_NIL;
+}
+
+bool ConcurrentPush(ConcurrentStack* stack, int32_t item) {
+    bool lostRace;
+    uint32_t index;
+    do {
+        index = _tryPopNode(&stack->free, stack->nodes, &lostRace);
+        if (index == CONCURRENT_STACK_NIL && !lostRace) {
+            return false;
+        }
+    } while (index == CONCURRENT_STACK_NIL);
+    stack->nodes[index].item = item;
+    for (;;) {
+        if (_tryPushNode(&stack->top, stack->nodes, index)) {
+            return true;
+        }
+        if (stack->eliminationSlots > 0 && _offerToPop(stack, index)) {
+            return true;
+        }
+    }
+}
+
+bool ConcurrentPop(ConcurrentStack* stack, int32_t* poppedItem) {
+    bool lostRace;
+    uint32_t index;
+    for (;;) {
+        index = _tryPopNode(&stack->top, stack->nodes, &lostRace);
+        if (index != CONCURRENT_STACK_NIL) {
+            break;
+        }
+        if (!lostRace) {
+            return false;
+        }
+        if (stack->eliminationSlots > 0) {
+            index = _takeFromPush(stack);
+            if (index != CONCURRENT_STACK_NIL) {
+                break;
+            }
+        }
+    }
+    *poppedItem = stack->nodes[index].item;
+    while (!_tryPushNode(&stack->free, stack->nodes, index)) {
+    }
+    return true;
+}
+
+bool ConcurrentIsEmpty(ConcurrentStack* stack) {
+    return TAGGED_INDEX(atomic_load_explicit(&stack->top, memory_order_relaxed)) == CONCURRENT_STACK_NIL;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define CACHE_LINE_SIZE 64
+#define CONCURRENT_STACK_NIL UINT32_MAX
+#define ELIMINATION_MAX_SLOTS 16
+// how long a push waits in the elimination array for a pop to take it
+#define ELIMINATION_SPINS 64
+
+// the top of a list is a tagged index: the node index in the low 32 bits and
+// a counter in the high 32 bits that grows with every change. If a node is
+// popped and pushed back while another thread is about to swap the top, the
+// index matches again but the tag does not, so that stale swap fails (ABA)
+#define TAGGED(tag, index) (((uint64_t)(tag) << 32) | (uint32_t)(index))
+#define TAGGED_INDEX(tagged) ((uint32_t)(tagged))
+#define TAGGED_TAG(tagged) ((uint32_t)((tagged) >> 32))
+
+typedef struct {
+    _Atomic uint32_t next;
+    int32_t item;
+} StackNode;
+
+// a push that keeps losing the race for the top can leave its node in a slot,
+// and a pop that keeps losing can take it from there, so the pair cancels out
+// without touching the top at all. The low bits hold the node index + 1, 0
+// when the slot is empty
+typedef struct {
+    _Alignas(CACHE_LINE_SIZE) _Atomic uint64_t exchange;
+} EliminationSlot;
+
+// a lock free stack of int32_t after R. K. Treiber, for any number of threads.
+// Nodes come from an array allocated up front, and the nodes that are not in
+// the stack form a second Treiber stack, the free list, so pushing and
+// popping never call malloc
+typedef struct {
+    _Alignas(CACHE_LINE_SIZE) _Atomic uint64_t top;
+    _Alignas(CACHE_LINE_SIZE) _Atomic uint64_t free;
+    EliminationSlot elimination[ELIMINATION_MAX_SLOTS];
+    uint32_t eliminationSlots;
+    uint32_t capacity;
+    StackNode* nodes;
+} ConcurrentStack;
+
+// eliminationSlots goes up to ELIMINATION_MAX_SLOTS, 0 turns elimination off
+ConcurrentStack* CreateConcurrentStack(uint32_t capacity, uint32_t eliminationSlots);
+void DestroyConcurrentStack(ConcurrentStack** stackp);
+// false when all the nodes are in use
+bool ConcurrentPush(ConcurrentStack* stack, int32_t item);
+bool ConcurrentPop(ConcurrentStack* stack, int32_t* poppedItem);
+// only a hint while other threads push and pop
+bool ConcurrentIsEmpty(ConcurrentStack* stack);
+
+bool _tryPushNode(_Atomic uint64_t* top, StackNode* nodes, uint32_t index);
+uint32_t _tryPopNode(_Atomic uint64_t* top, StackNode* nodes, bool* lostRace);
+bool _offerToPop(ConcurrentStack* stack, uint32_t index);
+uint32_t _takeFromPush(ConcurrentStack* stack);
+uint32_t _pickEliminationSlot(ConcurrentStack* stack);
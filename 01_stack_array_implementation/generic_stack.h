@@ -0,0 +1,114 @@
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define GENERIC_STACK_MIN_CAPACITY 8
+#define GENERIC_STACK_GROWTH_FACTOR 2
+
+// DEFINE_STACK(IntStack, int32_t) declares a stack of int32_t called
+// IntStack and its functions IntStackInit, IntStackPush, IntStackPop...
+// The stack starts empty and grows on the heap as items are pushed.
+//
+// DEFINE_SMALL_STACK(Name, Type, InlineCapacity) also keeps room for
+// InlineCapacity items inside the struct itself, so a stack that never
+// gets deeper than that never touches the heap. Since items may point
+// into the struct, a small stack must not be copied once it is in use.
+//
+// Both kinds live wherever the caller puts them: Init them before
+// use and Destroy them to release what they took from the heap.
+#define DEFINE_STACK(Name, Type)                                               \
+    typedef struct {                                                           \
+        Type* items;                                                           \
+        uint32_t capacity;                                                     \
+        uint32_t size;                                                         \
+    } Name;                                                                    \
+    _DEFINE_STACK_FUNCTIONS(Name, Type, NULL, 0)
+
+#define DEFINE_SMALL_STACK(Name, Type, InlineCapacity)                         \
+    typedef struct {                                                           \
+        Type* items;                                                           \
+        uint32_t capacity;                                                     \
+        uint32_t size;                                                         \
+        Type inlineItems[InlineCapacity];                                      \
+    } Name;                                                                    \
+    _DEFINE_STACK_FUNCTIONS(Name, Type, stack->inlineItems, InlineCapacity)
+
+// INLINE_ITEMS is an expression of `stack`, or NULL for plain stacks
+#define _DEFINE_STACK_FUNCTIONS(Name, Type, INLINE_ITEMS, InlineCapacity)      \
+    static inline void Name##Init(Name* stack) {                               \
+        stack->items = INLINE_ITEMS;                                           \
+        stack->capacity = InlineCapacity;                                      \
+        stack->size = 0;                                                       \
+    }                                                                          \
+                                                                               \
+    static inline void Name##Destroy(Name* stack) {                            \
+        if (stack->items != INLINE_ITEMS) {                                    \
+            free(stack->items);                                                \
+        }                                                                      \
+        Name##Init(stack);                                                     \
+    }                                                                          \
+                                                                               \
+    /* on failure the stack keeps its items and its old capacity */            \
+    static inline bool Name##Reserve(Name* stack, uint32_t capacity) {         \
+        if (capacity <= stack->capacity) {                                     \
+            return true;                                                       \
+        }                                                                      \
+        if ((size_t)capacity > SIZE_MAX / sizeof(Type)) {                      \
+            return false;                                                      \
+        }                                                                      \
+        Type* items;                                                           \
+        if (stack->items == INLINE_ITEMS) {                                    \
+            items = malloc(capacity * sizeof(Type));                           \
+            if (items != NULL && stack->size > 0) {                            \
+                memcpy(items, stack->items, stack->size * sizeof(Type));       \
+            }                                                                  \
+        } else {                                                               \
+            items = realloc(stack->items, capacity * sizeof(Type));            \
+        }                                                                      \
+        if (items == NULL) {                                                   \
+            return false;                                                      \
+        }                                                                      \
+        stack->items = items;                                                  \
+        stack->capacity = capacity;                                            \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    static inline bool Name##Push(Name* stack, Type item) {                    \
+        if (stack->size == stack->capacity) {                                  \
+            uint32_t capacity = stack->capacity < GENERIC_STACK_MIN_CAPACITY   \
+                ? GENERIC_STACK_MIN_CAPACITY                                   \
+                : stack->capacity > UINT32_MAX / GENERIC_STACK_GROWTH_FACTOR   \
+                ? UINT32_MAX                                                   \
+                : stack->capacity * GENERIC_STACK_GROWTH_FACTOR;               \
+            if (stack->size == UINT32_MAX                                      \
+                || !Name##Reserve(stack, capacity)) {                          \
+                return false;                                                  \
+            }                                                                  \
+        }                                                                      \
+        stack->items[stack->size] = item;                                      \
+        stack->size += 1;                                                      \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    static inline bool Name##Pop(Name* stack, Type* poppedItem) {              \
+        if (stack->size == 0) return false;                                    \
+        stack->size -= 1;                                                      \
+        *poppedItem = stack->items[stack->size];                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    static inline bool Name##Peek(Name* stack, Type* peekedItem) {             \
+        if (stack->size == 0) return false;                                    \
+        *peekedItem = stack->items[stack->size - 1];                           \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    static inline bool Name##IsEmpty(Name* stack) {                            \
+        return stack->size == 0;                                               \
+    }                                                                          \
+                                                                               \
+    static inline bool Name##IsInline(Name* stack) {                           \
+        return stack->items == INLINE_ITEMS;                                   \
+    }
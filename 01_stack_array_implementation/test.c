@@ -2,7 +2,21 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <pthread.h>
 #include "stack.h"
+#include "generic_stack.h"
+#include "concurrent_stack.h"
+
+#define STACK_THREADS 4
+#define ROUNDS_PER_THREAD 50000
+
+typedef struct {
+    int32_t x;
+    int32_t y;
+} Point;
+
+DEFINE_STACK(IntStack, int32_t)
+DEFINE_SMALL_STACK(SmallPointStack, Point, 4)
 
 void _cleanup(Stack* stack) {
     DestroyStack(&stack);
@@ -79,9 +93,150 @@ void TestEdgeCases() {
     _testPoppingEmptyStack();
 }
 
+void _testGenericStackGrows() {
+    IntStack stack;
+    IntStackInit(&stack);
+    assert(stack.items == NULL && stack.capacity == 0);
+    int32_t i, popped;
+    for (i = 0; i < 100000; i++) {
+        assert(IntStackPush(&stack, i) == true);
+    }
+    assert(stack.size == 100000);
+    assert(stack.capacity >= stack.size);
+    assert(IntStackPeek(&stack, &popped) == true && popped == 99999);
+    for (i = 99999; i >= 0; i--) {
+        assert(IntStackPop(&stack, &popped) == true);
+        assert(popped == i);
+    }
+    assert(IntStackIsEmpty(&stack) == true);
+    assert(IntStackPop(&stack, &popped) == false);
+    assert(IntStackReserve(&stack, 1000000) == true);
+    assert(stack.capacity == 1000000);
+    IntStackDestroy(&stack);
+    assert(stack.items == NULL && stack.size == 0);
+}
+
+void _testSmallStackStaysInline() {
+    SmallPointStack stack;
+    SmallPointStackInit(&stack);
+    Point point;
+    int32_t i;
+    for (i = 0; i < 4; i++) {
+        Point item = { i, -i };
+        assert(SmallPointStackPush(&stack, item) == true);
+    }
+    // up to its inline capacity the stack does not touch the heap
+    assert(SmallPointStackIsInline(&stack) == true);
+    Point fifth = { 4, -4 };
+    assert(SmallPointStackPush(&stack, fifth) == true);
+    assert(SmallPointStackIsInline(&stack) == false);
+    for (i = 4; i >= 0; i--) {
+        assert(SmallPointStackPop(&stack, &point) == true);
+        assert(point.x == i && point.y == -i);
+    }
+    SmallPointStackDestroy(&stack);
+    assert(SmallPointStackIsInline(&stack) == true);
+    assert(stack.capacity == 4);
+}
+
+void TestGenericStack() {
+    _testGenericStackGrows();
+    _testSmallStackStaysInline();
+}
+
+void _testConcurrentStackSingleThread() {
+    ConcurrentStack* stack = CreateConcurrentStack(3, 4);
+    assert(stack != NULL);
+    int32_t item;
+    assert(ConcurrentIsEmpty(stack) == true);
+    assert(ConcurrentPop(stack, &item) == false);
+    int32_t i;
+    for (i = 0; i < 3; i++) {
+        assert(ConcurrentPush(stack, i) == true);
+    }
+    assert(ConcurrentPush(stack, 3) == false);
+    for (i = 2; i >= 0; i--) {
+        assert(ConcurrentPop(stack, &item) == true);
+        assert(item == i);
+    }
+    assert(ConcurrentIsEmpty(stack) == true);
+    // the freed nodes are reused
+    assert(ConcurrentPush(stack, 7) == true);
+    assert(ConcurrentPop(stack, &item) == true && item == 7);
+    DestroyConcurrentStack(&stack);
+    assert(stack == NULL);
+
+    // with one slot, the pop and the push always meet in it
+    stack = CreateConcurrentStack(3, 1);
+    atomic_store(&stack->elimination[0].exchange, TAGGED(5, 2 + 1));
+    assert(_takeFromPush(stack) == 2);
+    assert(_takeFromPush(stack) == CONCURRENT_STACK_NIL);
+    // nobody takes the offer, so it is withdrawn
+    assert(_offerToPop(stack, 1) == false);
+    assert(TAGGED_INDEX(atomic_load(&stack->elimination[0].exchange)) == 0);
+    DestroyConcurrentStack(&stack);
+    assert(CreateConcurrentStack(0, 0) == NULL);
+    assert(CreateConcurrentStack(8, ELIMINATION_MAX_SLOTS + 1) == NULL);
+}
+
+typedef struct {
+    ConcurrentStack* stack;
+    int32_t id;
+    uint8_t* seen;
+} StackWorker;
+
+// items are id * ROUNDS_PER_THREAD * 2 + n, so every pushed item is unique
+void* _pushAndPop(void* arg) {
+    StackWorker* worker = arg;
+    int32_t base = worker->id * ROUNDS_PER_THREAD * 2;
+    int32_t i, item;
+    for (i = 0; i < ROUNDS_PER_THREAD; i++) {
+        assert(ConcurrentPush(worker->stack, base + 2 * i) == true);
+        assert(ConcurrentPush(worker->stack, base + 2 * i + 1) == true);
+        // every thread pushes before it pops, so the stack is never empty here
+        assert(ConcurrentPop(worker->stack, &item) == true);
+        __atomic_fetch_add(&worker->seen[item], 1, __ATOMIC_RELAXED);
+        assert(ConcurrentPop(worker->stack, &item) == true);
+        __atomic_fetch_add(&worker->seen[item], 1, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+void _testConcurrentStackManyThreads(uint32_t eliminationSlots) {
+    ConcurrentStack* stack = CreateConcurrentStack(STACK_THREADS * 2, eliminationSlots);
+    uint8_t* seen = calloc(STACK_THREADS * ROUNDS_PER_THREAD * 2, 1);
+    StackWorker workers[STACK_THREADS];
+    pthread_t threads[STACK_THREADS];
+    int32_t i;
+    for (i = 0; i < STACK_THREADS; i++) {
+        workers[i].stack = stack;
+        workers[i].id = i;
+        workers[i].seen = seen;
+        pthread_create(&threads[i], NULL, _pushAndPop, &workers[i]);
+    }
+    for (i = 0; i < STACK_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    // every item was popped exactly once
+    for (i = 0; i < STACK_THREADS * ROUNDS_PER_THREAD * 2; i++) {
+        assert(seen[i] == 1);
+    }
+    assert(ConcurrentIsEmpty(stack) == true);
+    free(seen);
+    DestroyConcurrentStack(&stack);
+}
+
+void TestConcurrentStack() {
+    _testConcurrentStackSingleThread();
+    _testConcurrentStackManyThreads(0);
+    _testConcurrentStackManyThreads(ELIMINATION_MAX_SLOTS);
+}
+
 int main(void) {
     TestCreateStack();
     TestHappyPath();
     TestEdgeCases();
+    TestGenericStack();
+    TestConcurrentStack();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "linked_list.h"
+#include "unrolled_list.h"
+
+#define LIST_SIZE 30000
+#define TRAVERSALS 200
+#define POSITIONAL_OPERATIONS 2000
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+unsigned int _random(unsigned int* state) {
+    *state = *state * 1103515245 + 12345;
+    return *state >> 8;
+}
+
+int main(void) {
+    unsigned int state = 12345;
+    int32_t i;
+    int64_t sum = 0;
+
+    // built in the same random order, so the nodes are spread over the heap
+    // the way a long-lived list ends up
+    Node* head = NULL;
+    UnrolledList* list = CreateUnrolledList();
+    for (i = 0; i < LIST_SIZE; i++) {
+        uint32_t position = _random(&state) % (i + 1);
+        InsertAtNthPosition(&head, i, position);
+        UnrolledInsertAtNthPosition(list, i, position);
+    }
+    uint32_t nodes = 0;
+    UnrolledNode* unrolledNode;
+    for (unrolledNode = list->head; unrolledNode != NULL; unrolledNode = unrolledNode->next) {
+        nodes++;
+    }
+
+    double start = _nowSeconds();
+    int t;
+    for (t = 0; t < TRAVERSALS; t++) {
+        Node* currentNode;
+        for (currentNode = head; currentNode != NULL; currentNode = currentNode->next) {
+            sum += currentNode->data;
+        }
+    }
+    double listTraversal = _nowSeconds() - start;
+    start = _nowSeconds();
+    for (t = 0; t < TRAVERSALS; t++) {
+        for (unrolledNode = list->head; unrolledNode != NULL; unrolledNode = unrolledNode->next) {
+            uint32_t j;
+            for (j = 0; j < unrolledNode->count; j++) {
+                sum += unrolledNode->values[j];
+            }
+        }
+    }
+    double unrolledTraversal = _nowSeconds() - start;
+
+    // the same random positions for both lists
+    unsigned int positionsState = state;
+    start = _nowSeconds();
+    for (i = 0; i < POSITIONAL_OPERATIONS; i++) {
+        InsertAtNthPosition(&head, i, _random(&state) % LIST_SIZE);
+        RemoveFromNthPosition(&head, _random(&state) % LIST_SIZE);
+    }
+    double listPositional = _nowSeconds() - start;
+    state = positionsState;
+    start = _nowSeconds();
+    for (i = 0; i < POSITIONAL_OPERATIONS; i++) {
+        UnrolledInsertAtNthPosition(list, i, _random(&state) % LIST_SIZE);
+        UnrolledRemoveFromNthPosition(list, _random(&state) % LIST_SIZE);
+    }
+    double unrolledPositional = _nowSeconds() - start;
+
+    printf("%d values, %u unrolled nodes\n", LIST_SIZE, nodes);
+    printf("%-10s traversal %6.2f ns per value   insert+remove %8.1f us   %5.1f bytes per value\n", "Node",
+        listTraversal * 1e9 / ((double)TRAVERSALS * LIST_SIZE), listPositional * 1e6 / POSITIONAL_OPERATIONS,
+        (double)sizeof(Node));
+    printf("%-10s traversal %6.2f ns per value   insert+remove %8.1f us   %5.1f bytes per value\n", "Unrolled",
+        unrolledTraversal * 1e9 / ((double)TRAVERSALS * LIST_SIZE), unrolledPositional * 1e6 / POSITIONAL_OPERATIONS,
+        (double)nodes * sizeof(UnrolledNode) / LIST_SIZE);
+    // printed so the compiler can not drop the traversals
+    printf("checksum %lld\n", (long long)sum);
+
+    while (RemoveFromNthPosition(&head, 0) == 0) {
+    }
+    DestroyUnrolledList(&list);
+    return 0;
+}
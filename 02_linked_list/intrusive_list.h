@@ -0,0 +1,152 @@
+#pragma once
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// an intrusive doubly linked list: instead of nodes that point to the
+// values, the values embed a ListLink and the list chains those links.
+// Nothing is allocated by the list, and a value that knows its link can
+// be unlinked without walking to it.
+//
+//     typedef struct { int id; ListLink link; } Task;
+//     ListPushBack(&queue, &task->link);
+//     Task* first = LIST_ENTRY(ListFront(&queue), Task, link);
+//
+// The list is circular around a sentinel link that lives in the list
+// itself, so no operation needs to check for the ends. That also means
+// an IntrusiveList must not be copied or moved once initialized.
+typedef struct ListLink_T
+{
+    struct ListLink_T* prev;
+    struct ListLink_T* next;
+} ListLink;
+
+typedef struct
+{
+    ListLink sentinel;
+    uint32_t size;
+} IntrusiveList;
+
+// the struct that embeds link as its member
+#define LIST_ENTRY(link, Type, member) ((Type*)((char*)(link) - offsetof(Type, member)))
+
+// link must not be unlinked inside the loop, use ListPopFront for that
+#define LIST_FOR_EACH(link, list)                                              \
+    for ((link) = (list)->sentinel.next; (link) != &(list)->sentinel;          \
+         (link) = (link)->next)
+
+static inline void InitList(IntrusiveList* list) {
+    list->sentinel.prev = &list->sentinel;
+    list->sentinel.next = &list->sentinel;
+    list->size = 0;
+}
+
+// a link that is not in any list points nowhere, so ListIsLinked can tell
+static inline void InitListLink(ListLink* link) {
+    link->prev = NULL;
+    link->next = NULL;
+}
+
+static inline bool ListIsLinked(ListLink* link) {
+    return link->next != NULL;
+}
+
+static inline bool ListIsEmpty(IntrusiveList* list) {
+    return list->size == 0;
+}
+
+static inline void _listInsertBetween(ListLink* link, ListLink* prev, ListLink* next) {
+    link->prev = prev;
+    link->next = next;
+    prev->next = link;
+    next->prev = link;
+}
+
+static inline void ListInsertAfter(IntrusiveList* list, ListLink* at, ListLink* link) {
+    _listInsertBetween(link, at, at->next);
+    list->size++;
+}
+
+static inline void ListInsertBefore(IntrusiveList* list, ListLink* at, ListLink* link) {
+    _listInsertBetween(link, at->prev, at);
+    list->size++;
+}
+
+static inline void ListPushFront(IntrusiveList* list, ListLink* link) {
+    ListInsertAfter(list, &list->sentinel, link);
+}
+
+static inline void ListPushBack(IntrusiveList* list, ListLink* link) {
+    ListInsertBefore(list, &list->sentinel, link);
+}
+
+// link must be in list
+static inline void ListUnlink(IntrusiveList* list, ListLink* link) {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    InitListLink(link);
+    list->size--;
+}
+
+// NULL when the list is empty
+static inline ListLink* ListFront(IntrusiveList* list) {
+    return list->size == 0 ? NULL : list->sentinel.next;
+}
+
+static inline ListLink* ListBack(IntrusiveList* list) {
+    return list->size == 0 ? NULL : list->sentinel.prev;
+}
+
+static inline ListLink* ListPopFront(IntrusiveList* list) {
+    ListLink* link = ListFront(list);
+    if (link != NULL) {
+        ListUnlink(list, link);
+    }
+    return link;
+}
+
+static inline ListLink* ListPopBack(IntrusiveList* list) {
+    ListLink* link = ListBack(list);
+    if (link != NULL) {
+        ListUnlink(list, link);
+    }
+    return link;
+}
+
+// what an LRU does on every hit
+static inline void ListMoveToFront(IntrusiveList* list, ListLink* link) {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    _listInsertBetween(link, &list->sentinel, list->sentinel.next);
+}
+
+// moves every link of other to the end of list, leaving other empty
+static inline void ListSpliceBack(IntrusiveList* list, IntrusiveList* other) {
+    if (other->size == 0 || list == other) {
+        return;
+    }
+    ListLink* first = other->sentinel.next;
+    ListLink* last = other->sentinel.prev;
+    first->prev = list->sentinel.prev;
+    list->sentinel.prev->next = first;
+    last->next = &list->sentinel;
+    list->sentinel.prev = last;
+    list->size += other->size;
+    InitList(other);
+}
+
+// moves every link of other to the front of list, leaving other empty
+static inline void ListSpliceFront(IntrusiveList* list, IntrusiveList* other) {
+    if (other->size == 0 || list == other) {
+        return;
+    }
+    ListLink* first = other->sentinel.next;
+    ListLink* last = other->sentinel.prev;
+    last->next = list->sentinel.next;
+    list->sentinel.next->prev = last;
+    first->prev = &list->sentinel;
+    list->sentinel.next = first;
+    list->size += other->size;
+    InitList(other);
+}
@@ -4,32 +4,66 @@
 #include "linked_list.h"
 
 Node* CreateNewNode() {
+    return _createNode(NULL);
+}
+
+Node* _createNode(Pool* pool) {
+    if (pool != NULL) {
+        return (Node*)PoolAlloc(pool);
+    }
     return (Node*)malloc(sizeof(Node));
 }
 
+void _freeNode(Pool* pool, Node* node) {
+    if (pool != NULL) {
+        PoolFree(pool, node);
+        return;
+    }
+    free(node);
+}
+
 void InsertToHead(Node** pointerToHead, uint32_t number)
 {
-    Node* newNode = CreateNewNode();
+    InsertToHeadWithPool(pointerToHead, number, NULL);
+}
+
+int InsertToHeadWithPool(Node** pointerToHead, uint32_t number, Pool* pool)
+{
+    Node* newNode = _createNode(pool);
+    if (newNode == NULL) {
+        return 1;
+    }
     newNode->data = number;
     newNode->next = *pointerToHead;
     *pointerToHead = newNode;
+    return 0;
 };
 
 int InsertAtNthPosition(Node** head, int32_t number, uint32_t position) {
+    return InsertAtNthPositionWithPool(head, number, position, NULL);
+}
+
+int InsertAtNthPositionWithPool(Node** head, int32_t number, uint32_t position, Pool* pool) {
     if (head == NULL) {
         return 1;
     }
     if (position == 0) {
-        InsertToHead(head, number);
-        return 0;
+        return InsertToHeadWithPool(head, number, pool);
     }
 
-    int32_t i;
+    // a position past the end of the list is an error, not a walk off of it
+    uint32_t i;
     Node* prevNode = *head;
-    for (i = 1; i < position; i++) {
+    for (i = 1; i < position && prevNode != NULL; i++) {
         prevNode = prevNode->next;
     }
-    Node* newNode = CreateNewNode();
+    if (prevNode == NULL) {
+        return 1;
+    }
+    Node* newNode = _createNode(pool);
+    if (newNode == NULL) {
+        return 1;
+    }
     newNode->data = number;
     newNode->next = prevNode->next;
     prevNode->next = newNode;
@@ -37,6 +71,10 @@ int InsertAtNthPosition(Node** head, int32_t number, uint32_t position) {
 }
 
 int RemoveFromNthPosition(Node** head, uint32_t position) {
+    return RemoveFromNthPositionWithPool(head, position, NULL);
+}
+
+int RemoveFromNthPositionWithPool(Node** head, uint32_t position, Pool* pool) {
     if (*head == NULL) {
         return 1;
     }
@@ -45,7 +83,7 @@ int RemoveFromNthPosition(Node** head, uint32_t position) {
     if (position == 0) {
         toDelete = *head;
         *head = (*head)->next;
-        free(toDelete);
+        _freeNode(pool, toDelete);
         return 0;
     }
 
@@ -61,7 +99,7 @@ int RemoveFromNthPosition(Node** head, uint32_t position) {
 
     toDelete = prevNode->next;
     prevNode->next = toDelete->next;
-    free(toDelete);
+    _freeNode(pool, toDelete);
     return 0;
 }
 
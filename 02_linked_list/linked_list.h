@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdio.h>
+#include "pool.h"
 
 typedef struct Node_T
 {
@@ -11,11 +12,25 @@ typedef struct Node_T
 
 Node* CreateNewNode();
 
+Node* _createNode(Pool* pool);
+
+void _freeNode(Pool* pool, Node* node);
+
 void InsertToHead(Node** head, uint32_t number);
 
 int InsertAtNthPosition(Node** head, int32_t number, uint32_t position);
 
 int RemoveFromNthPosition(Node** head, uint32_t position);
 
+// the same operations for a list whose nodes come from pool instead of
+// malloc, so the whole list can be dropped with PoolReset. Every node of
+// a list has to come from the same pool, or all of them from malloc.
+// Inserting returns 1 and leaves the list as it was when no node can be had
+int InsertToHeadWithPool(Node** head, uint32_t number, Pool* pool);
+
+int InsertAtNthPositionWithPool(Node** head, int32_t number, uint32_t position, Pool* pool);
+
+int RemoveFromNthPositionWithPool(Node** head, uint32_t position, Pool* pool);
+
 void PrintAll(Node* head);
 
@@ -2,7 +2,11 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <assert.h>
+#include <string.h>
+#include <stdbool.h>
 #include "linked_list.h"
+#include "unrolled_list.h"
+#include "intrusive_list.h"
 
 void _cleanUp(Node** head) {
     int shouldStop = 0;
@@ -116,6 +120,19 @@ void _testInsertAtTheBeginingAndTheEnd(int32_t desiredNodeNumber) {
     assert(head == NULL);
 }
 
+void TestInsertPastTheEnd() {
+    Node* head = NULL;
+    assert(InsertAtNthPosition(&head, 1, 1) == 1);
+    assert(head == NULL);
+    InsertToHead(&head, 0);
+    InsertToHead(&head, 0);
+    assert(InsertAtNthPosition(&head, 1, 3) == 1);
+    assert(InsertAtNthPosition(&head, 1, 100) == 1);
+    assert(InsertAtNthPosition(&head, 1, 2) == 0);
+    assert(head->next->next->data == 1);
+    _cleanUp(&head);
+}
+
 void TestLinkedListOrdering() {
     int32_t testCases[4] = { 10, 100, 1000, 10000 };
     int i, len;
@@ -152,10 +169,187 @@ void TestRemoveFromLastPosition() {
     }
 }
 
+void TestNodesFromPool() {
+    Pool* pool = CreatePool(sizeof(Node), 64);
+    int32_t nodeNumbers = 1000;
+    int32_t i;
+    Node* head = NULL;
+    for (i = 0; i < nodeNumbers; i++) {
+        InsertToHeadWithPool(&head, nodeNumbers - 1 - i, pool);
+    }
+    RemoveFromNthPositionWithPool(&head, 0, pool);
+    Node* recycled = pool->freeList == NULL ? NULL : (Node*)pool->freeList;
+    assert(recycled != NULL);
+    InsertToHeadWithPool(&head, 0, pool);
+    assert(head == recycled);
+    assert(InsertAtNthPositionWithPool(&head, -1, 1, pool) == 0);
+    assert(head->next->data == -1);
+    assert(RemoveFromNthPositionWithPool(&head, 1, pool) == 0);
+
+    // a pool that can not get a block leaves the list alone
+    Pool* emptyPool = CreatePool(sizeof(Node), SIZE_MAX / 64);
+    Node* failedHead = head;
+    assert(InsertToHeadWithPool(&failedHead, 1, emptyPool) == 1);
+    assert(InsertAtNthPositionWithPool(&failedHead, 1, 0, emptyPool) == 1);
+    assert(InsertAtNthPositionWithPool(&failedHead, 1, 1, emptyPool) == 1);
+    assert(failedHead == head && head->next->data == 1);
+    DestroyPool(&emptyPool);
+
+    // a list on malloc next to the pooled one is not affected by it
+    Node* heapHead = NULL;
+    InsertToHead(&heapHead, 7);
+    assert(RemoveFromNthPosition(&heapHead, 0) == 0);
+    assert(heapHead == NULL);
+
+    Node* currentNode = head;
+    for (i = 0; i < nodeNumbers; i++) {
+        assert(currentNode->data == i);
+        currentNode = currentNode->next;
+    }
+    assert(currentNode == NULL);
+
+    // the whole list goes away at once
+    PoolReset(pool);
+    head = NULL;
+    DestroyPool(&pool);
+}
+
+void _assertUnrolledMatches(UnrolledList* list, int32_t* expected, uint32_t size) {
+    assert(list->size == size);
+    uint32_t i = 0, nodes = 0;
+    UnrolledNode* currentNode;
+    for (currentNode = list->head; currentNode != NULL; currentNode = currentNode->next) {
+        uint32_t j;
+        // only the last node may be less than half full
+        assert(currentNode->count > 0);
+        assert(currentNode->next == NULL || currentNode->count >= UNROLLED_NODE_CAPACITY / 2);
+        for (j = 0; j < currentNode->count; j++) {
+            assert(currentNode->values[j] == expected[i++]);
+        }
+        nodes++;
+    }
+    assert(i == size);
+    int32_t value;
+    if (size > 0) {
+        assert(UnrolledGet(list, size - 1, &value) == 0 && value == expected[size - 1]);
+    }
+    assert(UnrolledGet(list, size, &value) == 1);
+}
+
+void TestUnrolledList() {
+    int32_t expected[5000];
+    uint32_t size = 0, i;
+    unsigned int state = 42;
+    UnrolledList* list = CreateUnrolledList();
+    assert(UnrolledRemoveFromNthPosition(list, 0) == 1);
+    assert(UnrolledInsertAtNthPosition(list, 1, 1) == 1);
+    // mostly inserts at first, then mostly removes, at random positions
+    for (i = 0; i < 20000; i++) {
+        state = state * 1103515245 + 12345;
+        uint32_t random = state >> 8;
+        bool insert = size == 0 || (size < 5000 && random % 100 < (i < 10000 ? 70 : 30));
+        if (insert) {
+            uint32_t position = random % (size + 1);
+            assert(UnrolledInsertAtNthPosition(list, (int32_t)i, position) == 0);
+            memmove(expected + position + 1, expected + position, (size - position) * sizeof(int32_t));
+            expected[position] = i;
+            size++;
+        } else {
+            uint32_t position = random % size;
+            assert(UnrolledRemoveFromNthPosition(list, position) == 0);
+            memmove(expected + position, expected + position + 1, (size - position - 1) * sizeof(int32_t));
+            size--;
+        }
+        if (i % 500 == 0) {
+            _assertUnrolledMatches(list, expected, size);
+        }
+    }
+    _assertUnrolledMatches(list, expected, size);
+    while (list->size > 0) {
+        assert(UnrolledRemoveFromNthPosition(list, list->size - 1) == 0);
+    }
+    assert(list->head == NULL);
+    DestroyUnrolledList(&list);
+    assert(list == NULL);
+}
+
+typedef struct {
+    int32_t id;
+    ListLink link;
+} Task;
+
+int32_t _taskId(ListLink* link) {
+    return LIST_ENTRY(link, Task, link)->id;
+}
+
+void _assertListIds(IntrusiveList* list, int32_t* expected, uint32_t len) {
+    assert(list->size == len);
+    uint32_t i = 0;
+    ListLink* link;
+    LIST_FOR_EACH(link, list) {
+        assert(_taskId(link) == expected[i++]);
+        // every link points back to the one before it
+        assert(link->prev->next == link);
+    }
+    assert(i == len);
+}
+
+void TestIntrusiveList() {
+    Task tasks[6];
+    int32_t i;
+    for (i = 0; i < 6; i++) {
+        tasks[i].id = i;
+        InitListLink(&tasks[i].link);
+    }
+    IntrusiveList queue, other;
+    InitList(&queue);
+    InitList(&other);
+    assert(ListIsEmpty(&queue) && ListFront(&queue) == NULL && ListPopBack(&queue) == NULL);
+
+    ListPushBack(&queue, &tasks[1].link);
+    ListPushBack(&queue, &tasks[2].link);
+    ListPushFront(&queue, &tasks[0].link);
+    int32_t pushed[] = { 0, 1, 2 };
+    _assertListIds(&queue, pushed, 3);
+    assert(ListIsLinked(&tasks[1].link) && !ListIsLinked(&tasks[3].link));
+
+    // a known node leaves the list without a walk
+    ListUnlink(&queue, &tasks[1].link);
+    assert(!ListIsLinked(&tasks[1].link));
+    ListMoveToFront(&queue, &tasks[2].link);
+    int32_t moved[] = { 2, 0 };
+    _assertListIds(&queue, moved, 2);
+
+    ListPushBack(&other, &tasks[3].link);
+    ListPushBack(&other, &tasks[4].link);
+    ListSpliceBack(&queue, &other);
+    assert(ListIsEmpty(&other));
+    ListPushBack(&other, &tasks[5].link);
+    ListPushBack(&other, &tasks[1].link);
+    ListSpliceFront(&queue, &other);
+    ListSpliceBack(&queue, &other);
+    int32_t spliced[] = { 5, 1, 2, 0, 3, 4 };
+    _assertListIds(&queue, spliced, 6);
+
+    assert(_taskId(ListPopBack(&queue)) == 4);
+    assert(_taskId(ListPopFront(&queue)) == 5);
+    ListInsertAfter(&queue, &tasks[2].link, &tasks[4].link);
+    ListInsertBefore(&queue, &tasks[1].link, &tasks[5].link);
+    int32_t inserted[] = { 5, 1, 2, 4, 0, 3 };
+    _assertListIds(&queue, inserted, 6);
+    while (ListPopFront(&queue) != NULL) {
+    }
+    assert(ListIsEmpty(&queue) && queue.sentinel.next == &queue.sentinel);
+}
+
 int main(void) {
     TestLinkedListOrdering();
     TestInsertAtSomePlace();
     TestInsertAtTheBeginingAndTheEnd();
     TestRemoveFromLastPosition();
+    TestNodesFromPool();
+    TestUnrolledList();
+    TestInsertPastTheEnd();
+    TestIntrusiveList();
     return 0;
 }
@@ -0,0 +1,162 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "unrolled_list.h"
+
+UnrolledList* CreateUnrolledList() {
+    UnrolledList* list = (UnrolledList*)malloc(sizeof(UnrolledList));
+    if (list == NULL) {
+        return NULL;
+    }
+    list->head = NULL;
+    list->size = 0;
+    return list;
+}
+
+void DestroyUnrolledList(UnrolledList** list) {
+    if (list == NULL || *list == NULL) {
+        return;
+    }
+    UnrolledNode* currentNode = (*list)->head;
+    while (currentNode != NULL) {
+        UnrolledNode* next = currentNode->next;
+        free(currentNode);
+        currentNode = next;
+    }
+    free(*list);
+    *list = NULL;
+}
+
+UnrolledNode* _createUnrolledNode() {
+    UnrolledNode* node = (UnrolledNode*)malloc(sizeof(UnrolledNode));
+    if (node == NULL) {
+        return NULL;
+    }
+    node->next = NULL;
+    node->count = 0;
+    return node;
+}
+
+// moves the upper half of a full node into a new node right after it
+UnrolledNode* _splitUnrolledNode(UnrolledNode* node) {
+    UnrolledNode* newNode = _createUnrolledNode();
+    if (newNode == NULL) {
+        return NULL;
+    }
+    uint32_t keep = (UNROLLED_NODE_CAPACITY + 1) / 2;
+    newNode->count = node->count - keep;
+    memcpy(newNode->values, node->values + keep, newNode->count * sizeof(int32_t));
+    node->count = keep;
+    newNode->next = node->next;
+    node->next = newNode;
+    return newNode;
+}
+
+int UnrolledInsertAtNthPosition(UnrolledList* list, int32_t number, uint32_t position) {
+    if (list == NULL || position > list->size) {
+        return 1;
+    }
+    if (list->head == NULL) {
+        list->head = _createUnrolledNode();
+        if (list->head == NULL) {
+            return 1;
+        }
+    }
+    // a position right after the last value of a node goes at the end of
+    // that node, so appending to the list never starts a new node early
+    UnrolledNode* node = list->head;
+    while (position > node->count) {
+        position -= node->count;
+        node = node->next;
+    }
+    if (node->count == UNROLLED_NODE_CAPACITY) {
+        UnrolledNode* newNode = _splitUnrolledNode(node);
+        if (newNode == NULL) {
+            return 1;
+        }
+        if (position > node->count) {
+            position -= node->count;
+            node = newNode;
+        }
+    }
+    memmove(node->values + position + 1, node->values + position, (node->count - position) * sizeof(int32_t));
+    node->values[position] = number;
+    node->count++;
+    list->size++;
+    return 0;
+}
+
+// after a removal, empty nodes are unlinked and nodes less than half full
+// take values from the next one, or absorb it when both fit in one node
+void _rebalanceUnrolledNode(UnrolledList* list, UnrolledNode* node, UnrolledNode* previous) {
+    if (node->count == 0) {
+        if (previous == NULL) {
+            list->head = node->next;
+        } else {
+            previous->next = node->next;
+        }
+        free(node);
+        return;
+    }
+    UnrolledNode* next = node->next;
+    if (node->count >= UNROLLED_NODE_CAPACITY / 2 || next == NULL) {
+        return;
+    }
+    if (node->count + next->count <= UNROLLED_NODE_CAPACITY) {
+        memcpy(node->values + node->count, next->values, next->count * sizeof(int32_t));
+        node->count += next->count;
+        node->next = next->next;
+        free(next);
+        return;
+    }
+    uint32_t moved = UNROLLED_NODE_CAPACITY / 2 - node->count;
+    memcpy(node->values + node->count, next->values, moved * sizeof(int32_t));
+    memmove(next->values, next->values + moved, (next->count - moved) * sizeof(int32_t));
+    node->count += moved;
+    next->count -= moved;
+}
+
+int UnrolledRemoveFromNthPosition(UnrolledList* list, uint32_t position) {
+    if (list == NULL || position >= list->size) {
+        return 1;
+    }
+    UnrolledNode* previous = NULL;
+    UnrolledNode* node = list->head;
+    while (position >= node->count) {
+        position -= node->count;
+        previous = node;
+        node = node->next;
+    }
+    memmove(node->values + position, node->values + position + 1, (node->count - position - 1) * sizeof(int32_t));
+    node->count--;
+    list->size--;
+    _rebalanceUnrolledNode(list, node, previous);
+    return 0;
+}
+
+int UnrolledGet(UnrolledList* list, uint32_t position, int32_t* value) {
+    if (list == NULL || value == NULL || position >= list->size) {
+        return 1;
+    }
+    UnrolledNode* node = list->head;
+    while (position >= node->count) {
+        position -= node->count;
+        node = node->next;
+    }
+    *value = node->values[position];
+    return 0;
+}
+
+void UnrolledPrintAll(UnrolledList* list) {
+    printf("The current values of the unrolled linked list are: [ ");
+    UnrolledNode* currentNode = list == NULL ? NULL : list->head;
+    while (currentNode != NULL) {
+        uint32_t i;
+        for (i = 0; i < currentNode->count; i++) {
+            printf("%d ", currentNode->values[i]);
+        }
+        currentNode = currentNode->next;
+    }
+    printf("]\n");
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// 29 values, the count and the next pointer fill two cache lines
+#define UNROLLED_NODE_CAPACITY 29
+
+// a linked list where every node holds up to UNROLLED_NODE_CAPACITY values,
+// so a walk visits one node per few dozen values instead of one per value.
+// Every node but the last is kept at least half full
+typedef struct UnrolledNode_T
+{
+    struct UnrolledNode_T* next;
+    uint32_t count;
+    int32_t values[UNROLLED_NODE_CAPACITY];
+} UnrolledNode;
+
+typedef struct
+{
+    UnrolledNode* head;
+    uint32_t size;
+} UnrolledList;
+
+UnrolledList* CreateUnrolledList();
+
+void DestroyUnrolledList(UnrolledList** list);
+
+// positions count values, not nodes. Like the Node list, these return 0 on
+// success and 1 when the position is past the end or memory runs out
+int UnrolledInsertAtNthPosition(UnrolledList* list, int32_t number, uint32_t position);
+
+int UnrolledRemoveFromNthPosition(UnrolledList* list, uint32_t position);
+
+int UnrolledGet(UnrolledList* list, uint32_t position, int32_t* value);
+
+void UnrolledPrintAll(UnrolledList* list);
+
+UnrolledNode* _createUnrolledNode();
+UnrolledNode* _splitUnrolledNode(UnrolledNode* node);
+void _rebalanceUnrolledNode(UnrolledList* list, UnrolledNode* node, UnrolledNode* previous);
@@ -0,0 +1,368 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "array_kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define KERNELS_X86
+#include <immintrin.h>
+#endif
+
+bool _findScalar(const int32_t* values, uint32_t len, int32_t value, uint32_t* index) {
+    uint32_t i;
+    for (i = 0; i < len; i++) {
+        if (values[i] == value) {
+            *index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t _countScalar(const int32_t* values, uint32_t len, int32_t value) {
+    uint32_t count = 0, i;
+    for (i = 0; i < len; i++) {
+        count += values[i] == value;
+    }
+    return count;
+}
+
+int64_t _sumScalar(const int32_t* values, uint32_t len) {
+    int64_t sum = 0;
+    uint32_t i;
+    for (i = 0; i < len; i++) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+void _minMaxScalar(const int32_t* values, uint32_t len, int32_t* min, int32_t* max) {
+    // locals, since writes through min and max could alias values
+    int32_t low = *min, high = *max;
+    uint32_t i;
+    for (i = 0; i < len; i++) {
+        low = values[i] < low ? values[i] : low;
+        high = values[i] > high ? values[i] : high;
+    }
+    *min = low;
+    *max = high;
+}
+
+// every value is written, and only the kept ones move the output forward
+uint32_t _filterScalar(const int32_t* values, uint32_t len, int32_t low, int32_t high, int32_t* out) {
+    uint32_t kept = 0, i;
+    for (i = 0; i < len; i++) {
+        out[kept] = values[i];
+        kept += values[i] >= low && values[i] <= high;
+    }
+    return kept;
+}
+
+static const ArrayKernels scalarKernels = {
+    _findScalar, _countScalar, _sumScalar, _minMaxScalar, _filterScalar,
+};
+
+#ifdef KERNELS_X86
+// for each mask of kept lanes, the shuffle that packs those lanes to the
+// front and how many lanes that is. Counting through a table avoids needing
+// the popcnt instruction on top of SSE4.1
+static uint8_t sseCompress[16][16];
+static uint32_t avx2Compress[256][8];
+static uint8_t keptLanes[256];
+
+void _buildCompressTables() {
+    unsigned int mask, lane;
+    for (mask = 0; mask < 16; mask++) {
+        unsigned int kept = 0;
+        memset(sseCompress[mask], 0x80, 16);
+        for (lane = 0; lane < 4; lane++) {
+            if ((mask >> lane) & 1) {
+                unsigned int byte;
+                for (byte = 0; byte < 4; byte++) {
+                    sseCompress[mask][kept * 4 + byte] = lane * 4 + byte;
+                }
+                kept++;
+            }
+        }
+    }
+    for (mask = 0; mask < 256; mask++) {
+        keptLanes[mask] = __builtin_popcount(mask);
+    }
+    for (mask = 0; mask < 256; mask++) {
+        unsigned int kept = 0;
+        memset(avx2Compress[mask], 0, sizeof(avx2Compress[mask]));
+        for (lane = 0; lane < 8; lane++) {
+            if ((mask >> lane) & 1) {
+                avx2Compress[mask][kept++] = lane;
+            }
+        }
+    }
+}
+
+__attribute__((target("sse4.1")))
+bool _findSse(const int32_t* values, uint32_t len, int32_t value, uint32_t* index) {
+    __m128i needle = _mm_set1_epi32(value);
+    uint32_t i;
+    for (i = 0; i + 4 <= len; i += 4) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(values + i));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, needle)));
+        if (mask != 0) {
+            *index = i + __builtin_ctz(mask);
+            return true;
+        }
+    }
+    if (_findScalar(values + i, len - i, value, index)) {
+        *index += i;
+        return true;
+    }
+    return false;
+}
+
+__attribute__((target("sse4.1")))
+uint32_t _countSse(const int32_t* values, uint32_t len, int32_t value) {
+    __m128i needle = _mm_set1_epi32(value);
+    // a match compares to -1, so subtracting it counts one per lane
+    __m128i counts = _mm_setzero_si128();
+    uint32_t i;
+    for (i = 0; i + 4 <= len; i += 4) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(values + i));
+        counts = _mm_sub_epi32(counts, _mm_cmpeq_epi32(block, needle));
+    }
+    uint32_t lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, counts);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + _countScalar(values + i, len - i, value);
+}
+
+__attribute__((target("sse4.1")))
+int64_t _sumSse(const int32_t* values, uint32_t len) {
+    __m128i low = _mm_setzero_si128(), high = _mm_setzero_si128();
+    uint32_t i;
+    for (i = 0; i + 4 <= len; i += 4) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(values + i));
+        low = _mm_add_epi64(low, _mm_cvtepi32_epi64(block));
+        high = _mm_add_epi64(high, _mm_cvtepi32_epi64(_mm_srli_si128(block, 8)));
+    }
+    int64_t lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, _mm_add_epi64(low, high));
+    return lanes[0] + lanes[1] + _sumScalar(values + i, len - i);
+}
+
+__attribute__((target("sse4.1")))
+void _minMaxSse(const int32_t* values, uint32_t len, int32_t* min, int32_t* max) {
+    __m128i low = _mm_set1_epi32(*min), high = _mm_set1_epi32(*max);
+    uint32_t i;
+    for (i = 0; i + 4 <= len; i += 4) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(values + i));
+        low = _mm_min_epi32(low, block);
+        high = _mm_max_epi32(high, block);
+    }
+    int32_t lows[4], highs[4];
+    _mm_storeu_si128((__m128i*)lows, low);
+    _mm_storeu_si128((__m128i*)highs, high);
+    _minMaxScalar(lows, 4, min, max);
+    _minMaxScalar(highs, 4, min, max);
+    _minMaxScalar(values + i, len - i, min, max);
+}
+
+__attribute__((target("sse4.1")))
+uint32_t _filterSse(const int32_t* values, uint32_t len, int32_t low, int32_t high, int32_t* out) {
+    __m128i lows = _mm_set1_epi32(low), highs = _mm_set1_epi32(high);
+    uint32_t kept = 0, i;
+    for (i = 0; i + 4 <= len; i += 4) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(values + i));
+        __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(lows, block), _mm_cmpgt_epi32(block, highs));
+        int mask = ~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0xF;
+        __m128i shuffle = _mm_loadu_si128((const __m128i*)sseCompress[mask]);
+        // kept <= i, so the full store stays inside the len values out has room for
+        _mm_storeu_si128((__m128i*)(out + kept), _mm_shuffle_epi8(block, shuffle));
+        kept += keptLanes[mask];
+    }
+    return kept + _filterScalar(values + i, len - i, low, high, out + kept);
+}
+
+__attribute__((target("avx2")))
+bool _findAvx2(const int32_t* values, uint32_t len, int32_t value, uint32_t* index) {
+    __m256i needle = _mm256_set1_epi32(value);
+    uint32_t i;
+    for (i = 0; i + 8 <= len; i += 8) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(values + i));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block, needle)));
+        if (mask != 0) {
+            *index = i + __builtin_ctz(mask);
+            return true;
+        }
+    }
+    if (_findScalar(values + i, len - i, value, index)) {
+        *index += i;
+        return true;
+    }
+    return false;
+}
+
+__attribute__((target("avx2")))
+uint32_t _countAvx2(const int32_t* values, uint32_t len, int32_t value) {
+    __m256i needle = _mm256_set1_epi32(value);
+    __m256i counts = _mm256_setzero_si256();
+    uint32_t i;
+    for (i = 0; i + 8 <= len; i += 8) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(values + i));
+        counts = _mm256_sub_epi32(counts, _mm256_cmpeq_epi32(block, needle));
+    }
+    uint32_t lanes[8], count = 0, lane;
+    _mm256_storeu_si256((__m256i*)lanes, counts);
+    for (lane = 0; lane < 8; lane++) {
+        count += lanes[lane];
+    }
+    return count + _countScalar(values + i, len - i, value);
+}
+
+__attribute__((target("avx2")))
+int64_t _sumAvx2(const int32_t* values, uint32_t len) {
+    __m256i low = _mm256_setzero_si256(), high = _mm256_setzero_si256();
+    uint32_t i;
+    for (i = 0; i + 8 <= len; i += 8) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(values + i));
+        low = _mm256_add_epi64(low, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(block)));
+        high = _mm256_add_epi64(high, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(block, 1)));
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, _mm256_add_epi64(low, high));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + _sumScalar(values + i, len - i);
+}
+
+__attribute__((target("avx2")))
+void _minMaxAvx2(const int32_t* values, uint32_t len, int32_t* min, int32_t* max) {
+    __m256i low = _mm256_set1_epi32(*min), high = _mm256_set1_epi32(*max);
+    uint32_t i;
+    for (i = 0; i + 8 <= len; i += 8) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(values + i));
+        low = _mm256_min_epi32(low, block);
+        high = _mm256_max_epi32(high, block);
+    }
+    int32_t lows[8], highs[8];
+    _mm256_storeu_si256((__m256i*)lows, low);
+    _mm256_storeu_si256((__m256i*)highs, high);
+    _minMaxScalar(lows, 8, min, max);
+    _minMaxScalar(highs, 8, min, max);
+    _minMaxScalar(values + i, len - i, min, max);
+}
+
+__attribute__((target("avx2")))
+uint32_t _filterAvx2(const int32_t* values, uint32_t len, int32_t low, int32_t high, int32_t* out) {
+    __m256i lows = _mm256_set1_epi32(low), highs = _mm256_set1_epi32(high);
+    uint32_t kept = 0, i;
+    for (i = 0; i + 8 <= len; i += 8) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(values + i));
+        __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(lows, block), _mm256_cmpgt_epi32(block, highs));
+        int mask = ~_mm256_movemask_ps(_mm256_castsi256_ps(outside)) & 0xFF;
+        __m256i permutation = _mm256_loadu_si256((const __m256i*)avx2Compress[mask]);
+        _mm256_storeu_si256((__m256i*)(out + kept), _mm256_permutevar8x32_epi32(block, permutation));
+        kept += keptLanes[mask];
+    }
+    return kept + _filterScalar(values + i, len - i, low, high, out + kept);
+}
+
+static const ArrayKernels sseKernels = {
+    _findSse, _countSse, _sumSse, _minMaxSse, _filterSse,
+};
+
+static const ArrayKernels avx2Kernels = {
+    _findAvx2, _countAvx2, _sumAvx2, _minMaxAvx2, _filterAvx2,
+};
+#endif
+
+static const ArrayKernels* activeKernels = &scalarKernels;
+static KernelLevel activeLevel = KERNELS_SCALAR;
+
+KernelLevel DetectKernelLevel() {
+#ifdef KERNELS_X86
+    // constructors may run before the CPU model is filled in
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return KERNELS_AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return KERNELS_SSE41;
+    }
+#endif
+    return KERNELS_SCALAR;
+}
+
+bool UseKernelLevel(KernelLevel level) {
+    if (level > DetectKernelLevel()) {
+        return false;
+    }
+    switch (level) {
+#ifdef KERNELS_X86
+    case KERNELS_AVX2:
+        activeKernels = &avx2Kernels;
+        break;
+    case KERNELS_SSE41:
+        activeKernels = &sseKernels;
+        break;
+#endif
+    default:
+        activeKernels = &scalarKernels;
+        break;
+    }
+    activeLevel = level;
+    return true;
+}
+
+KernelLevel ActiveKernelLevel() {
+    return activeLevel;
+}
+
+// runs before main, so the tables are ready before any thread can scan
+__attribute__((constructor))
+void _initKernels() {
+#ifdef KERNELS_X86
+    _buildCompressTables();
+#endif
+    UseKernelLevel(DetectKernelLevel());
+}
+
+bool FindValue(D_array* array, int32_t value, uint32_t* index) {
+    if (array == NULL || array->collection == NULL || index == NULL) {
+        return false;
+    }
+    return activeKernels->find(array->collection, array->size, value, index);
+}
+
+uint32_t CountValue(D_array* array, int32_t value) {
+    if (array == NULL || array->collection == NULL) {
+        return 0;
+    }
+    return activeKernels->count(array->collection, array->size, value);
+}
+
+int64_t SumArray(D_array* array) {
+    if (array == NULL || array->collection == NULL) {
+        return 0;
+    }
+    return activeKernels->sum(array->collection, array->size);
+}
+
+bool MinMaxArray(D_array* array, int32_t* min, int32_t* max) {
+    if (array == NULL || array->collection == NULL || array->size == 0 || min == NULL || max == NULL) {
+        return false;
+    }
+    *min = array->collection[0];
+    *max = array->collection[0];
+    activeKernels->minMax(array->collection, array->size, min, max);
+    return true;
+}
+
+D_array* FilterInRange(D_array* array, int32_t low, int32_t high) {
+    if (array == NULL || array->collection == NULL) {
+        return NULL;
+    }
+    // room for every element, the kernels store whole vectors
+    D_array* filtered = CreateDynamicArrayWithPolicy(array->size, array->growthFactor, array->shrinkThreshold);
+    if (filtered == NULL) {
+        return NULL;
+    }
+    filtered->size = activeKernels->filter(array->collection, array->size, low, high, filtered->collection);
+    return filtered;
+}
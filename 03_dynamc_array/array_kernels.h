@@ -0,0 +1,44 @@
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "dynamic_array.h"
+
+// scans over the elements of a D_array. Each one has a scalar, an SSE4.1
+// and an AVX2 version, and the first call picks the widest one the CPU
+// supports. The results are the same whichever version runs
+typedef enum {
+    KERNELS_SCALAR,
+    KERNELS_SSE41,
+    KERNELS_AVX2,
+} KernelLevel;
+
+typedef struct {
+    bool (*find)(const int32_t* values, uint32_t len, int32_t value, uint32_t* index);
+    uint32_t (*count)(const int32_t* values, uint32_t len, int32_t value);
+    int64_t (*sum)(const int32_t* values, uint32_t len);
+    void (*minMax)(const int32_t* values, uint32_t len, int32_t* min, int32_t* max);
+    // out must have room for len values
+    uint32_t (*filter)(const int32_t* values, uint32_t len, int32_t low, int32_t high, int32_t* out);
+} ArrayKernels;
+
+// index receives the position of the first element equal to value
+bool FindValue(D_array* array, int32_t value, uint32_t* index);
+uint32_t CountValue(D_array* array, int32_t value);
+// summed in 64 bits, so it does not overflow
+int64_t SumArray(D_array* array);
+// false when the array is empty
+bool MinMaxArray(D_array* array, int32_t* min, int32_t* max);
+// a new array with the elements between low and high, both included, in order
+D_array* FilterInRange(D_array* array, int32_t low, int32_t high);
+
+KernelLevel DetectKernelLevel();
+// false, keeping the current kernels, if the CPU can not run that level
+bool UseKernelLevel(KernelLevel level);
+KernelLevel ActiveKernelLevel();
+
+bool _findScalar(const int32_t* values, uint32_t len, int32_t value, uint32_t* index);
+uint32_t _countScalar(const int32_t* values, uint32_t len, int32_t value);
+int64_t _sumScalar(const int32_t* values, uint32_t len);
+void _minMaxScalar(const int32_t* values, uint32_t len, int32_t* min, int32_t* max);
+uint32_t _filterScalar(const int32_t* values, uint32_t len, int32_t low, int32_t high, int32_t* out);
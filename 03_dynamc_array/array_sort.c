@@ -0,0 +1,329 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "array_sort.h"
+
+// flipping the sign bit makes the unsigned order of the keys their signed order
+#define RADIX_KEY(value) ((uint32_t)(value) ^ 0x80000000u)
+
+bool RadixSort(D_array* array) {
+    if (array == NULL || array->collection == NULL) {
+        return false;
+    }
+    uint32_t len = array->size;
+    if (len < 2) {
+        return true;
+    }
+    int32_t* buffer = malloc((size_t)len * sizeof(int32_t));
+    if (buffer == NULL) {
+        return false;
+    }
+    // the counts of every byte are taken in a single pass over the keys
+    uint32_t counts[4][RADIX_BUCKETS];
+    memset(counts, 0, sizeof(counts));
+    uint32_t i;
+    for (i = 0; i < len; i++) {
+        uint32_t key = RADIX_KEY(array->collection[i]);
+        counts[0][key & 0xFF]++;
+        counts[1][(key >> 8) & 0xFF]++;
+        counts[2][(key >> 16) & 0xFF]++;
+        counts[3][key >> 24]++;
+    }
+
+    int32_t* source = array->collection;
+    int32_t* destination = buffer;
+    unsigned int pass;
+    for (pass = 0; pass < 4; pass++) {
+        unsigned int shift = pass * RADIX_BITS;
+        // a byte that every key shares would only copy the array
+        if (counts[pass][(RADIX_KEY(source[0]) >> shift) & 0xFF] == len) {
+            continue;
+        }
+        uint32_t offsets[RADIX_BUCKETS], total = 0, bucket;
+        for (bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+            offsets[bucket] = total;
+            total += counts[pass][bucket];
+        }
+        for (i = 0; i < len; i++) {
+            destination[offsets[(RADIX_KEY(source[i]) >> shift) & 0xFF]++] = source[i];
+        }
+        int32_t* swap = source;
+        source = destination;
+        destination = swap;
+    }
+    if (source != array->collection) {
+        memcpy(array->collection, source, (size_t)len * sizeof(int32_t));
+    }
+    free(buffer);
+    return true;
+}
+
+void _insertionSort(int32_t* values, uint32_t len) {
+    uint32_t i;
+    for (i = 1; i < len; i++) {
+        int32_t value = values[i];
+        uint32_t j = i;
+        while (j > 0 && values[j - 1] > value) {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = value;
+    }
+}
+
+void _heapSort(int32_t* values, uint32_t len) {
+    uint32_t end = len, start = len / 2;
+    while (end > 1) {
+        if (start > 0) {
+            // still building the heap
+            start--;
+        } else {
+            end--;
+            int32_t top = values[0];
+            values[0] = values[end];
+            values[end] = top;
+        }
+        uint32_t parent = start;
+        for (;;) {
+            uint32_t child = 2 * parent + 1;
+            if (child >= end) {
+                break;
+            }
+            if (child + 1 < end && values[child + 1] > values[child]) {
+                child++;
+            }
+            if (values[parent] >= values[child]) {
+                break;
+            }
+            int32_t swap = values[parent];
+            values[parent] = values[child];
+            values[child] = swap;
+            parent = child;
+        }
+    }
+}
+
+// Hoare partition around the median of the first, middle and last values.
+// Returns the length of the left part: everything before it is <= the
+// pivot and everything from it on is >= the pivot, and neither part is empty
+uint32_t _partition(int32_t* values, uint32_t len) {
+    uint32_t middle = len / 2;
+    int32_t swap;
+    if (values[middle] < values[0]) {
+        swap = values[middle]; values[middle] = values[0]; values[0] = swap;
+    }
+    if (values[len - 1] < values[middle]) {
+        swap = values[len - 1]; values[len - 1] = values[middle]; values[middle] = swap;
+        if (values[middle] < values[0]) {
+            swap = values[middle]; values[middle] = values[0]; values[0] = swap;
+        }
+    }
+    int32_t pivot = values[middle];
+    int64_t i = -1, j = len;
+    for (;;) {
+        do {
+            i++;
+        } while (values[i] < pivot);
+        do {
+            j--;
+        } while (values[j] > pivot);
+        if (i >= j) {
+            return j + 1;
+        }
+        swap = values[i];
+        values[i] = values[j];
+        values[j] = swap;
+    }
+}
+
+void _introSort(int32_t* values, uint32_t len, unsigned int depthLimit) {
+    while (len > SORT_INSERTION_THRESHOLD) {
+        if (depthLimit == 0) {
+            _heapSort(values, len);
+            return;
+        }
+        depthLimit--;
+        uint32_t split = _partition(values, len);
+        // recursing into the smaller part keeps the stack at log2(len) frames
+        if (split < len - split) {
+            _introSort(values, split, depthLimit);
+            values += split;
+            len -= split;
+        } else {
+            _introSort(values + split, len - split, depthLimit);
+            len = split;
+        }
+    }
+    // sorted right away, while the partition is still in cache
+    _insertionSort(values, len);
+}
+
+void IntroSort(D_array* array) {
+    if (array == NULL || array->collection == NULL || IsSorted(array)) {
+        return;
+    }
+    unsigned int depthLimit = 2 * (32 - __builtin_clz(array->size));
+    _introSort(array->collection, array->size, depthLimit);
+}
+
+bool IsSorted(D_array* array) {
+    if (array == NULL || array->collection == NULL) {
+        return false;
+    }
+    uint32_t i;
+    for (i = 1; i < array->size; i++) {
+        if (array->collection[i - 1] > array->collection[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void _merge(const int32_t* left, uint32_t leftLen, const int32_t* right, uint32_t rightLen, int32_t* out) {
+    const int32_t* leftEnd = left + leftLen;
+    const int32_t* rightEnd = right + rightLen;
+    while (left < leftEnd && right < rightEnd) {
+        // taking from the left on ties keeps the merge stable
+        bool takeRight = *right < *left;
+        *out++ = takeRight ? *right : *left;
+        right += takeRight;
+        left += !takeRight;
+    }
+    memcpy(out, left, (leftEnd - left) * sizeof(int32_t));
+    out += leftEnd - left;
+    memcpy(out, right, (rightEnd - right) * sizeof(int32_t));
+}
+
+void* _sortTask(void* arg) {
+    SortTask* task = arg;
+    uint32_t len = task->end - task->start;
+    if (len > 1) {
+        _introSort(task->values + task->start, len, 2 * (32 - __builtin_clz(len)));
+    }
+    return NULL;
+}
+
+// merges [start, middle) and [middle, end) of values into the same range of buffer
+void* _mergeTask(void* arg) {
+    SortTask* task = arg;
+    _merge(task->values + task->start, task->middle - task->start,
+        task->values + task->middle, task->end - task->middle, task->buffer + task->start);
+    return NULL;
+}
+
+// runs every task on its own thread, the first one on the calling thread.
+// A task whose thread could not be started runs on the calling thread too
+void _runTasks(SortTask* tasks, unsigned int count, void* (*run)(void*)) {
+    unsigned int i, started;
+    for (started = 1; started < count; started++) {
+        if (pthread_create(&tasks[started].thread, NULL, run, &tasks[started]) != 0) {
+            break;
+        }
+    }
+    run(&tasks[0]);
+    for (i = 1; i < count; i++) {
+        if (i < started) {
+            pthread_join(tasks[i].thread, NULL);
+        } else {
+            run(&tasks[i]);
+        }
+    }
+}
+
+bool ParallelSort(D_array* array, unsigned int threads) {
+    if (array == NULL || array->collection == NULL) {
+        return false;
+    }
+    if (threads > PARALLEL_SORT_MAX_THREADS) {
+        threads = PARALLEL_SORT_MAX_THREADS;
+    }
+    if (threads > array->size / PARALLEL_SORT_MIN_CHUNK) {
+        threads = array->size / PARALLEL_SORT_MIN_CHUNK;
+    }
+    if (threads <= 1 || IsSorted(array)) {
+        IntroSort(array);
+        return true;
+    }
+    int32_t* buffer = malloc((size_t)array->size * sizeof(int32_t));
+    if (buffer == NULL) {
+        return false;
+    }
+
+    SortTask tasks[PARALLEL_SORT_MAX_THREADS];
+    uint32_t bounds[PARALLEL_SORT_MAX_THREADS + 1];
+    unsigned int runs = threads, i;
+    for (i = 0; i <= runs; i++) {
+        bounds[i] = (uint64_t)array->size * i / runs;
+    }
+    for (i = 0; i < runs; i++) {
+        tasks[i].values = array->collection;
+        tasks[i].start = bounds[i];
+        tasks[i].end = bounds[i + 1];
+    }
+    _runTasks(tasks, runs, _sortTask);
+
+    // every round merges the runs two by two, going back and forth
+    // between the array and the buffer
+    int32_t* source = array->collection;
+    int32_t* destination = buffer;
+    while (runs > 1) {
+        unsigned int merges = runs / 2;
+        for (i = 0; i < merges; i++) {
+            tasks[i].values = source;
+            tasks[i].buffer = destination;
+            tasks[i].start = bounds[2 * i];
+            tasks[i].middle = bounds[2 * i + 1];
+            tasks[i].end = bounds[2 * i + 2];
+        }
+        _runTasks(tasks, merges, _mergeTask);
+        if (runs % 2 == 1) {
+            // the last run has no partner this round
+            memcpy(destination + bounds[runs - 1], source + bounds[runs - 1],
+                (size_t)(bounds[runs] - bounds[runs - 1]) * sizeof(int32_t));
+        }
+        for (i = 0; i <= merges; i++) {
+            bounds[i] = bounds[2 * i < runs ? 2 * i : runs];
+        }
+        bounds[merges + runs % 2] = bounds[runs];
+        runs = merges + runs % 2;
+        int32_t* swap = source;
+        source = destination;
+        destination = swap;
+    }
+    if (source != array->collection) {
+        memcpy(array->collection, source, (size_t)array->size * sizeof(int32_t));
+    }
+    free(buffer);
+    return true;
+}
+
+// branchless: the loop always runs log2(size) times and the
+// compiler turns the comparison into a conditional move
+uint32_t LowerBound(D_array* array, int32_t value) {
+    if (array == NULL || array->collection == NULL || array->size == 0) {
+        return 0;
+    }
+    const int32_t* base = array->collection;
+    uint32_t len = array->size;
+    while (len > 1) {
+        uint32_t half = len / 2;
+        base = base[half] < value ? base + half : base;
+        len -= half;
+    }
+    return (base - array->collection) + (*base < value);
+}
+
+uint32_t UpperBound(D_array* array, int32_t value) {
+    if (array == NULL || array->collection == NULL || array->size == 0) {
+        return 0;
+    }
+    const int32_t* base = array->collection;
+    uint32_t len = array->size;
+    while (len > 1) {
+        uint32_t half = len / 2;
+        base = base[half] <= value ? base + half : base;
+        len -= half;
+    }
+    return (base - array->collection) + (*base <= value);
+}
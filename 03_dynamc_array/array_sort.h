@@ -0,0 +1,50 @@
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "dynamic_array.h"
+
+#define SORT_INSERTION_THRESHOLD 16
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define PARALLEL_SORT_MAX_THREADS 64
+#define PARALLEL_SORT_MIN_CHUNK (1 << 16)
+
+// all the sorts are ascending and in place
+//
+// LSD radix sort: one counting pass per byte of the keys, skipping the
+// bytes every key shares. Needs a buffer as big as the array, so it
+// returns false, leaving the array as it was, when it can not get one
+bool RadixSort(D_array* array);
+// quicksort that falls back to heapsort when the partitions keep coming
+// out unbalanced, and to insertion sort for the small ones
+void IntroSort(D_array* array);
+// each thread introsorts a slice, then the sorted slices are merged in
+// rounds of pairs. Small arrays are sorted on the calling thread
+bool ParallelSort(D_array* array, unsigned int threads);
+bool IsSorted(D_array* array);
+
+// on a sorted array, the first position whose value is >= value (LowerBound)
+// or > value (UpperBound). Both return array->size when there is none, so
+// UpperBound - LowerBound is the number of elements equal to value
+uint32_t LowerBound(D_array* array, int32_t value);
+uint32_t UpperBound(D_array* array, int32_t value);
+
+typedef struct {
+    int32_t* values;
+    int32_t* buffer;
+    uint32_t start;
+    uint32_t middle;
+    uint32_t end;
+    pthread_t thread;
+} SortTask;
+
+void _insertionSort(int32_t* values, uint32_t len);
+void _heapSort(int32_t* values, uint32_t len);
+void _introSort(int32_t* values, uint32_t len, unsigned int depthLimit);
+uint32_t _partition(int32_t* values, uint32_t len);
+void _merge(const int32_t* left, uint32_t leftLen, const int32_t* right, uint32_t rightLen, int32_t* out);
+void* _sortTask(void* arg);
+void* _mergeTask(void* arg);
+void _runTasks(SortTask* tasks, unsigned int count, void* (*run)(void*));
@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "dynamic_array.h"
+
+#define BIG_ARRAY_PUSHES 50000000
+#define SMALL_ARRAYS 200000
+#define MAX_SMALL_SIZE 500
+#define BATCH_SIZE 64
+
+typedef struct {
+    char* name;
+    float growthFactor;
+    float shrinkThreshold;
+} Policy;
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void _benchPolicy(Policy* policy) {
+    D_array* big = CreateDynamicArrayWithPolicy(MIN_CAPACITY, policy->growthFactor, policy->shrinkThreshold);
+    int32_t i, value;
+    double start = _nowSeconds();
+    for (i = 0; i < BIG_ARRAY_PUSHES; i++) {
+        Push(big, i);
+    }
+    double pushTime = _nowSeconds() - start;
+    // after popping 90% of it, how much does the array still hold on to
+    while (big->size > BIG_ARRAY_PUSHES / 10) {
+        Pop(big, &value);
+    }
+    double keptAfterPops = (double)big->capacity / big->size;
+    DestroyDynamicArray(&big);
+
+    // many arrays of random sizes, like a service holding one per request
+    D_array** arrays = malloc(SMALL_ARRAYS * sizeof(D_array*));
+    uint64_t usedBytes = 0, reservedBytes = 0;
+    unsigned int state = 12345;
+    for (i = 0; i < SMALL_ARRAYS; i++) {
+        arrays[i] = CreateDynamicArrayWithPolicy(MIN_CAPACITY, policy->growthFactor, policy->shrinkThreshold);
+        state = state * 1103515245 + 12345;
+        int32_t size = 1 + (state >> 8) % MAX_SMALL_SIZE, j;
+        for (j = 0; j < size; j++) {
+            Push(arrays[i], j);
+        }
+        usedBytes += arrays[i]->size * sizeof(int32_t);
+        reservedBytes += arrays[i]->capacity * sizeof(int32_t);
+    }
+    for (i = 0; i < SMALL_ARRAYS; i++) {
+        DestroyDynamicArray(&arrays[i]);
+    }
+    free(arrays);
+
+    printf("%-20s push %5.2f ns   overhead %5.1f%%   capacity/size after 90%% pops %5.2f\n", policy->name,
+        pushTime * 1e9 / BIG_ARRAY_PUSHES, 100.0 * (reservedBytes - usedBytes) / usedBytes, keptAfterPops);
+}
+
+// appending batches like an ingest loop would, one element at a time
+// and then one batch per call
+void _benchBatches() {
+    int32_t batch[BATCH_SIZE];
+    int32_t i, j;
+    for (i = 0; i < BATCH_SIZE; i++) {
+        batch[i] = i;
+    }
+    D_array* array = CreateDynamicArray(MIN_CAPACITY);
+    double start = _nowSeconds();
+    for (i = 0; i < BIG_ARRAY_PUSHES / BATCH_SIZE; i++) {
+        for (j = 0; j < BATCH_SIZE; j++) {
+            Push(array, batch[j]);
+        }
+    }
+    double loopTime = _nowSeconds() - start;
+    DestroyDynamicArray(&array);
+
+    array = CreateDynamicArray(MIN_CAPACITY);
+    start = _nowSeconds();
+    for (i = 0; i < BIG_ARRAY_PUSHES / BATCH_SIZE; i++) {
+        PushMany(array, batch, BATCH_SIZE);
+    }
+    double batchTime = _nowSeconds() - start;
+    DestroyDynamicArray(&array);
+
+    printf("batches of %d: Push loop %5.2f ns   PushMany %5.2f ns per element\n", BATCH_SIZE,
+        loopTime * 1e9 / BIG_ARRAY_PUSHES, batchTime * 1e9 / BIG_ARRAY_PUSHES);
+}
+
+int main(void) {
+    Policy policies[] = {
+        { "2x, never shrink", 2, 0 },
+        { "1.5x, never shrink", 1.5f, 0 },
+        { "2x, shrink at 1/4", 2, 0.25f },
+        { "1.5x, shrink at 1/4", 1.5f, 0.25f },
+    };
+    int i, len = sizeof(policies) / sizeof(policies[0]);
+    for (i = 0; i < len; i++) {
+        _benchPolicy(&policies[i]);
+    }
+    _benchBatches();
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include "dynamic_array.h"
+#include "work_deque.h"
+
+#define OWNER_OPS 10000000
+#define SUM_SIZE (1 << 24)
+#define CHUNK_SIZE 4096
+#define MAX_THIEVES 7
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// what the owner pays when nobody steals: the deque against a D_array used as
+// a stack behind a mutex, which is what a shared task list would need
+void _benchOwner() {
+    WorkDeque* deque = CreateWorkDeque(WORK_DEQUE_MIN_CAPACITY);
+    void* item;
+    uintptr_t checksum = 0;
+    int i;
+    double start = _nowSeconds();
+    for (i = 0; i < OWNER_OPS; i++) {
+        DequePush(deque, (void*)(uintptr_t)i);
+        if (i % 2 == 1) {
+            DequePop(deque, &item);
+            checksum += (uintptr_t)item;
+            DequePop(deque, &item);
+            checksum += (uintptr_t)item;
+        }
+    }
+    double elapsed = _nowSeconds() - start;
+    printf("  work deque      %6.2f ns per push or pop   (checksum %lu)\n", elapsed * 1e9 / (OWNER_OPS * 2),
+        (unsigned long)checksum);
+    DestroyWorkDeque(&deque);
+
+    D_array* array = CreateDynamicArray(MIN_CAPACITY);
+    pthread_mutex_t lock;
+    pthread_mutex_init(&lock, NULL);
+    int32_t value;
+    checksum = 0;
+    start = _nowSeconds();
+    for (i = 0; i < OWNER_OPS; i++) {
+        pthread_mutex_lock(&lock);
+        Push(array, i);
+        pthread_mutex_unlock(&lock);
+        if (i % 2 == 1) {
+            pthread_mutex_lock(&lock);
+            Pop(array, &value);
+            pthread_mutex_unlock(&lock);
+            checksum += value;
+            pthread_mutex_lock(&lock);
+            Pop(array, &value);
+            pthread_mutex_unlock(&lock);
+            checksum += value;
+        }
+    }
+    elapsed = _nowSeconds() - start;
+    printf("  mutex + D_array %6.2f ns per push or pop   (checksum %lu)\n", elapsed * 1e9 / (OWNER_OPS * 2),
+        (unsigned long)checksum);
+    pthread_mutex_destroy(&lock);
+    DestroyDynamicArray(&array);
+}
+
+typedef struct {
+    uint32_t start;
+    uint32_t end;
+} SumTask;
+
+typedef struct {
+    WorkDeque* deque;
+    D_array* array;
+    _Atomic bool* done;
+    int64_t sum;
+    uint32_t tasks;
+    pthread_t thread;
+} Worker;
+
+void _runTask(Worker* worker, SumTask* task) {
+    uint32_t i;
+    for (i = task->start; i < task->end; i++) {
+        worker->sum += worker->array->collection[i];
+    }
+    worker->tasks++;
+}
+
+void* _thief(void* arg) {
+    Worker* worker = arg;
+    void* item;
+    for (;;) {
+        bool done = atomic_load_explicit(worker->done, memory_order_acquire);
+        StealResult result = DequeSteal(worker->deque, &item);
+        if (result == STEAL_SUCCESS) {
+            _runTask(worker, item);
+        } else if (result == STEAL_EMPTY) {
+            if (done) {
+                return NULL;
+            }
+            sched_yield();
+        }
+    }
+}
+
+// the owner splits a sum into chunks and works through them from the bottom,
+// while the thieves take chunks from the top
+void _benchSum(D_array* array, SumTask* tasks, unsigned int thieves) {
+    WorkDeque* deque = CreateWorkDeque(WORK_DEQUE_MIN_CAPACITY);
+    _Atomic bool done = false;
+    Worker workers[MAX_THIEVES + 1];
+    unsigned int i;
+    for (i = 0; i <= thieves; i++) {
+        workers[i].deque = deque;
+        workers[i].array = array;
+        workers[i].done = &done;
+        workers[i].sum = 0;
+        workers[i].tasks = 0;
+    }
+    double start = _nowSeconds();
+    for (i = 1; i <= thieves; i++) {
+        pthread_create(&workers[i].thread, NULL, _thief, &workers[i]);
+    }
+    uint32_t t;
+    for (t = 0; t < SUM_SIZE / CHUNK_SIZE; t++) {
+        DequePush(deque, &tasks[t]);
+    }
+    void* item;
+    while (DequePop(deque, &item)) {
+        _runTask(&workers[0], item);
+    }
+    atomic_store_explicit(&done, true, memory_order_release);
+    int64_t sum = workers[0].sum;
+    for (i = 1; i <= thieves; i++) {
+        pthread_join(workers[i].thread, NULL);
+        sum += workers[i].sum;
+    }
+    double elapsed = _nowSeconds() - start;
+    printf("  %u thieves   %7.2f ms   owner ran %5u of %u chunks   (sum %lld)\n", thieves, elapsed * 1e3,
+        workers[0].tasks, SUM_SIZE / CHUNK_SIZE, (long long)sum);
+    DestroyWorkDeque(&deque);
+}
+
+int main(void) {
+    printf("owner only, %d pushes and as many pops\n", OWNER_OPS);
+    _benchOwner();
+
+    D_array* array = CreateDynamicArray(SUM_SIZE);
+    uint32_t i;
+    for (i = 0; i < SUM_SIZE; i++) {
+        Push(array, (int32_t)(i % 1000));
+    }
+    SumTask* tasks = malloc((SUM_SIZE / CHUNK_SIZE) * sizeof(SumTask));
+    for (i = 0; i < SUM_SIZE / CHUNK_SIZE; i++) {
+        tasks[i].start = i * CHUNK_SIZE;
+        tasks[i].end = (i + 1) * CHUNK_SIZE;
+    }
+    printf("summing %d values in chunks of %d, %ld cores\n", SUM_SIZE, CHUNK_SIZE, sysconf(_SC_NPROCESSORS_ONLN));
+    unsigned int thieves;
+    for (thieves = 0; thieves <= MAX_THIEVES; thieves = thieves * 2 + 1) {
+        _benchSum(array, tasks, thieves);
+    }
+    free(tasks);
+    DestroyDynamicArray(&array);
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "dynamic_array.h"
+#include "array_kernels.h"
+
+// each measurement scans about this many elements in total
+#define ELEMENTS_PER_MEASUREMENT (1 << 27)
+
+typedef enum { OP_FIND, OP_COUNT, OP_SUM, OP_MIN_MAX, OP_FILTER } Operation;
+
+static const char* operationNames[] = { "find", "count", "sum", "min/max", "filter" };
+static const char* levelNames[] = { "scalar", "sse4.1", "avx2" };
+
+// what callers wrote before the library had kernels
+int64_t _naive(Operation op, D_array* array, D_array* out) {
+    uint32_t i;
+    int64_t result = 0;
+    int32_t min = array->collection[0], max = array->collection[0];
+    switch (op) {
+    case OP_FIND:
+        for (i = 0; i < array->size; i++) {
+            if (array->collection[i] == -1) return i;
+        }
+        return -1;
+    case OP_COUNT:
+        for (i = 0; i < array->size; i++) {
+            if (array->collection[i] == 3) result++;
+        }
+        return result;
+    case OP_SUM:
+        for (i = 0; i < array->size; i++) {
+            result += array->collection[i];
+        }
+        return result;
+    case OP_MIN_MAX:
+        for (i = 0; i < array->size; i++) {
+            if (array->collection[i] < min) min = array->collection[i];
+            if (array->collection[i] > max) max = array->collection[i];
+        }
+        return (int64_t)min + max;
+    case OP_FILTER:
+        out->size = 0;
+        for (i = 0; i < array->size; i++) {
+            if (array->collection[i] >= 0 && array->collection[i] < 500) {
+                out->collection[out->size++] = array->collection[i];
+            }
+        }
+        return out->size;
+    }
+    return 0;
+}
+
+int64_t _kernel(Operation op, D_array* array) {
+    uint32_t index;
+    int32_t min, max;
+    D_array* filtered;
+    int64_t result;
+    switch (op) {
+    case OP_FIND:
+        return FindValue(array, -1, &index) ? index : -1;
+    case OP_COUNT:
+        return CountValue(array, 3);
+    case OP_SUM:
+        return SumArray(array);
+    case OP_MIN_MAX:
+        MinMaxArray(array, &min, &max);
+        return (int64_t)min + max;
+    case OP_FILTER:
+        filtered = FilterInRange(array, 0, 499);
+        result = filtered->size;
+        DestroyDynamicArray(&filtered);
+        return result;
+    }
+    return 0;
+}
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// nanoseconds per element, level < 0 times the naive loop
+double _measure(Operation op, D_array* array, D_array* out, int level, int64_t* result) {
+    uint32_t rounds = ELEMENTS_PER_MEASUREMENT / array->size, round;
+    if (level >= 0) {
+        UseKernelLevel(level);
+    }
+    double start = _nowSeconds();
+    for (round = 0; round < rounds; round++) {
+        *result += level < 0 ? _naive(op, array, out) : _kernel(op, array);
+    }
+    return (_nowSeconds() - start) * 1e9 / ((double)rounds * array->size);
+}
+
+int main(void) {
+    uint32_t sizes[] = { 1 << 10, 1 << 16, 1 << 20, 1 << 24 };
+    int sizeCount = sizeof(sizes) / sizeof(sizes[0]), s, level;
+    KernelLevel best = DetectKernelLevel();
+    int64_t sink = 0;
+    Operation op;
+
+    printf("%-9s %10s %8s", "", "elements", "naive");
+    for (level = KERNELS_SCALAR; level <= (int)best; level++) {
+        printf(" %8s", levelNames[level]);
+    }
+    printf("   (ns per element)\n");
+    for (s = 0; s < sizeCount; s++) {
+        D_array* array = CreateDynamicArray(sizes[s]);
+        D_array* out = CreateDynamicArray(sizes[s]);
+        unsigned int state = 12345;
+        uint32_t i;
+        // values between 0 and 999, the searched -1 is never there
+        for (i = 0; i < sizes[s]; i++) {
+            state = state * 1103515245 + 12345;
+            Push(array, (state >> 8) % 1000);
+        }
+        for (op = OP_FIND; op <= OP_FILTER; op++) {
+            printf("%-9s %10u %8.3f", operationNames[op], sizes[s], _measure(op, array, out, -1, &sink));
+            for (level = KERNELS_SCALAR; level <= (int)best; level++) {
+                printf(" %8.3f", _measure(op, array, out, level, &sink));
+            }
+            printf("\n");
+        }
+        DestroyDynamicArray(&array);
+        DestroyDynamicArray(&out);
+    }
+    UseKernelLevel(best);
+    // printed so the compiler can not drop the loops
+    printf("checksum %lld\n", (long long)sink);
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "dynamic_array.h"
+#include "array_sort.h"
+
+#define SORT_SIZE (1 << 22)
+#define LOOKUPS 10000000
+
+static const char* patternNames[] = { "sorted", "reverse", "random", "few unique" };
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int _compareInt32(const void* a, const void* b) {
+    int32_t x = *(const int32_t*)a, y = *(const int32_t*)b;
+    return (x > y) - (x < y);
+}
+
+void _fillPattern(D_array* array, int pattern) {
+    unsigned int state = 12345;
+    uint32_t i;
+    for (i = 0; i < array->size; i++) {
+        state = state * 1103515245 + 12345;
+        array->collection[i] = pattern == 0 ? (int32_t)i
+            : pattern == 1 ? (int32_t)(array->size - i)
+            : pattern == 2 ? (int32_t)(state ^ (state << 16))
+            : (int32_t)(state >> 16) % 16;
+    }
+}
+
+// milliseconds for one sort of the pattern, sort is -1 for qsort,
+// 0 for radix, 1 for introsort, or the number of threads plus one
+double _measure(D_array* array, int pattern, int sort) {
+    _fillPattern(array, pattern);
+    double start = _nowSeconds();
+    if (sort == -1) qsort(array->collection, array->size, sizeof(int32_t), _compareInt32);
+    if (sort == 0) RadixSort(array);
+    if (sort == 1) IntroSort(array);
+    if (sort > 1) ParallelSort(array, sort - 1);
+    double elapsed = _nowSeconds() - start;
+    if (!IsSorted(array)) {
+        printf("not sorted!\n");
+        exit(1);
+    }
+    return elapsed * 1e3;
+}
+
+int main(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int maxThreads = cores > 4 ? cores : 4, threads;
+    D_array* array = CreateDynamicArray(SORT_SIZE);
+    Resize(array, SORT_SIZE, 0);
+
+    printf("%u elements, %ld cores, milliseconds per sort\n", SORT_SIZE, cores);
+    printf("%-12s %8s %8s %8s", "", "qsort", "radix", "intro");
+    for (threads = 2; threads <= maxThreads; threads *= 2) {
+        printf(" %7u%s", threads, "t");
+    }
+    printf("\n");
+    int pattern;
+    for (pattern = 0; pattern < 4; pattern++) {
+        printf("%-12s %8.1f %8.1f %8.1f", patternNames[pattern], _measure(array, pattern, -1),
+            _measure(array, pattern, 0), _measure(array, pattern, 1));
+        for (threads = 2; threads <= maxThreads; threads *= 2) {
+            printf(" %8.1f", _measure(array, pattern, threads + 1));
+        }
+        printf("\n");
+    }
+
+    _fillPattern(array, 2);
+    RadixSort(array);
+    unsigned int state = 777, i;
+    uint64_t sink = 0;
+    double start = _nowSeconds();
+    for (i = 0; i < LOOKUPS; i++) {
+        state = state * 1103515245 + 12345;
+        sink += LowerBound(array, (int32_t)(state ^ (state << 16)));
+    }
+    printf("LowerBound: %.1f ns per lookup (checksum %llu)\n",
+        (_nowSeconds() - start) * 1e9 / LOOKUPS, (unsigned long long)sink);
+    DestroyDynamicArray(&array);
+    return 0;
+}
@@ -2,9 +2,20 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 #include "dynamic_array.h"
 
 D_array* CreateDynamicArray(uint32_t capacity) {
+    return CreateDynamicArrayWithPolicy(capacity, DEFAULT_GROWTH_FACTOR, DEFAULT_SHRINK_THRESHOLD);
+}
+
+D_array* CreateDynamicArrayWithPolicy(uint32_t capacity, float growthFactor, float shrinkThreshold) {
+    if (growthFactor <= 1 || shrinkThreshold < 0 || shrinkThreshold * growthFactor >= 1) {
+        return NULL;
+    }
+    if (capacity < MIN_CAPACITY) {
+        capacity = MIN_CAPACITY;
+    }
     int32_t* collection = (int32_t*)calloc(capacity, sizeof(int32_t));
     if (collection == NULL) {
         return NULL;
@@ -18,18 +29,22 @@ D_array* CreateDynamicArray(uint32_t capacity) {
     array->collection = collection;
     array->size = 0;
     array->capacity = capacity;
+    array->reserved = 0;
+    array->growthFactor = growthFactor;
+    array->shrinkThreshold = shrinkThreshold;
     return array;
 }
 
 bool DestroyDynamicArray(D_array** array) {
-    D_array* arr = *array;
-    if (arr == NULL) {
+    if (array == NULL || *array == NULL) {
         return false;
     }
+    D_array* arr = *array;
     if (arr->collection != NULL) {
         free(arr->collection);
     }
     free(arr);
+    *array = NULL;
     return true;
 }
 
@@ -37,32 +52,71 @@ bool _needsToResize(D_array* array) {
     if (array == NULL) {
         return false;
     }
-    return  (array->size + 1) * 2 >= array->capacity;
+    return array->size == array->capacity;
 }
 
-bool _resize(D_array* array) {
-    if (array == NULL || array->collection == NULL) {
+bool _needsToShrink(D_array* array) {
+    if (array == NULL || array->capacity <= MIN_CAPACITY || array->capacity <= array->reserved) {
         return false;
     }
-    uint32_t newCapacity = 2 * array->capacity;
+    return array->size < array->capacity * array->shrinkThreshold;
+}
 
-    array->collection = (int32_t*)realloc(array->collection, sizeof(int32_t) * newCapacity);
+uint32_t _grownCapacity(D_array* array) {
+    double grown = (double)array->capacity * array->growthFactor;
+    if (grown >= UINT32_MAX) {
+        return UINT32_MAX;
+    }
+    // small factors on small arrays could round back to the same capacity
+    uint32_t newCapacity = (uint32_t)grown;
+    return newCapacity > array->capacity ? newCapacity : array->capacity + 1;
+}
 
-    if (array->collection == NULL) {
+bool _resize(D_array* array, uint32_t newCapacity) {
+    if (array == NULL || array->collection == NULL || newCapacity < array->size || newCapacity == 0) {
         return false;
     }
-
+    // on failure realloc leaves the old block alone, so the array stays usable
+    int32_t* collection = (int32_t*)realloc(array->collection, sizeof(int32_t) * (size_t)newCapacity);
+    if (collection == NULL) {
+        return false;
+    }
+    array->collection = collection;
     array->capacity = newCapacity;
+    return true;
+}
 
+bool Reserve(D_array* array, uint32_t capacity) {
+    if (array == NULL || array->collection == NULL) {
+        return false;
+    }
+    if (capacity > array->capacity && !_resize(array, capacity)) {
+        return false;
+    }
+    if (capacity > array->reserved) {
+        array->reserved = capacity;
+    }
     return true;
 }
 
+bool ShrinkToFit(D_array* array) {
+    if (array == NULL || array->collection == NULL) {
+        return false;
+    }
+    array->reserved = 0;
+    if (array->capacity == array->size) {
+        return true;
+    }
+    return _resize(array, array->size > 0 ? array->size : 1);
+}
+
 bool Push(D_array* array, int32_t val) {
     if (array == NULL || array->collection == NULL) {
         return false;
     }
     if (_needsToResize(array)) {
-        bool ok = _resize(array);
+        if (array->capacity == UINT32_MAX) return false;
+        bool ok = _resize(array, _grownCapacity(array));
         if (!ok) return false;
     }
     array->collection[array->size] = val;
@@ -83,6 +137,120 @@ bool Pop(D_array* array, int32_t* returnValue) {
         return false;
     }
     array->size--;
-    *returnValue = array->collection[array->size];;
+    *returnValue = array->collection[array->size];
+    _shrinkIfNeeded(array);
     return true;
-}
\ No newline at end of file
+}
+
+void _shrinkIfNeeded(D_array* array) {
+    if (!_needsToShrink(array)) {
+        return;
+    }
+    uint32_t newCapacity = (uint32_t)(array->size * array->growthFactor);
+    if (newCapacity < MIN_CAPACITY) {
+        newCapacity = MIN_CAPACITY;
+    }
+    if (newCapacity < array->reserved) {
+        newCapacity = array->reserved;
+    }
+    // failing to shrink only means keeping more memory than needed
+    _resize(array, newCapacity);
+}
+
+// grows the array once so that count more elements fit, following the
+// growth policy unless count alone asks for more than that
+bool _makeRoomFor(D_array* array, uint32_t count) {
+    if (count > UINT32_MAX - array->size) {
+        return false;
+    }
+    uint32_t needed = array->size + count;
+    if (needed <= array->capacity) {
+        return true;
+    }
+    uint32_t grown = _grownCapacity(array);
+    return _resize(array, grown > needed ? grown : needed);
+}
+
+bool PushMany(D_array* array, const int32_t* values, uint32_t count) {
+    if (array == NULL || array->collection == NULL || (values == NULL && count > 0)) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+    if (!_makeRoomFor(array, count)) {
+        return false;
+    }
+    memcpy(array->collection + array->size, values, count * sizeof(int32_t));
+    array->size += count;
+    return true;
+}
+
+bool AppendArray(D_array* array, D_array* other) {
+    if (array == NULL || other == NULL || other->collection == NULL) {
+        return false;
+    }
+    uint32_t count = other->size;
+    if (array == other) {
+        // the source moves with the resize, so it is read after it
+        if (!_makeRoomFor(array, count)) {
+            return false;
+        }
+        memcpy(array->collection + array->size, array->collection, count * sizeof(int32_t));
+        array->size += count;
+        return true;
+    }
+    return PushMany(array, other->collection, count);
+}
+
+bool InsertRange(D_array* array, uint32_t position, const int32_t* values, uint32_t count) {
+    if (array == NULL || array->collection == NULL || position > array->size || (values == NULL && count > 0)) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+    if (!_makeRoomFor(array, count)) {
+        return false;
+    }
+    int32_t* at = array->collection + position;
+    memmove(at + count, at, (array->size - position) * sizeof(int32_t));
+    memcpy(at, values, count * sizeof(int32_t));
+    array->size += count;
+    return true;
+}
+
+bool EraseRange(D_array* array, uint32_t position, uint32_t count) {
+    if (array == NULL || array->collection == NULL || position > array->size || count > array->size - position) {
+        return false;
+    }
+    int32_t* at = array->collection + position;
+    memmove(at, at + count, (array->size - position - count) * sizeof(int32_t));
+    array->size -= count;
+    _shrinkIfNeeded(array);
+    return true;
+}
+
+bool Resize(D_array* array, uint32_t size, int32_t fill) {
+    if (array == NULL || array->collection == NULL) {
+        return false;
+    }
+    if (size <= array->size) {
+        array->size = size;
+        _shrinkIfNeeded(array);
+        return true;
+    }
+    if (!_makeRoomFor(array, size - array->size)) {
+        return false;
+    }
+    uint32_t i;
+    if (fill == 0) {
+        memset(array->collection + array->size, 0, (size - array->size) * sizeof(int32_t));
+    } else {
+        for (i = array->size; i < size; i++) {
+            array->collection[i] = fill;
+        }
+    }
+    array->size = size;
+    return true;
+}
@@ -3,16 +3,50 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#define DEFAULT_GROWTH_FACTOR 1.5f
+#define DEFAULT_SHRINK_THRESHOLD 0.25f
+#define MIN_CAPACITY 4
+
+// the array grows by growthFactor when it is full. Once Pop leaves it
+// less than shrinkThreshold full, it shrinks back to growthFactor times
+// its size, so it is never left full right after shrinking and pushes
+// and pops around the threshold do not resize every time.
+// A shrinkThreshold of 0 disables shrinking.
+// Shrinking never goes below reserved, the largest capacity asked for
+// with Reserve, until ShrinkToFit gives it back
 typedef struct
 {
     int32_t* collection;
     u_int32_t capacity;
     u_int32_t size;
+    u_int32_t reserved;
+    float growthFactor;
+    float shrinkThreshold;
 } D_array;
 
 D_array* CreateDynamicArray(uint32_t capacity);
+// growthFactor must be > 1, and shrinkThreshold * growthFactor < 1
+D_array* CreateDynamicArrayWithPolicy(uint32_t capacity, float growthFactor, float shrinkThreshold);
 bool DestroyDynamicArray(D_array**);
 bool Push(D_array* array, int32_t val);
 bool Pop(D_array* array, int32_t* returnValue);
 bool IsEmpty(D_array* array);
+bool Reserve(D_array* array, uint32_t capacity);
+bool ShrinkToFit(D_array* array);
+
+// bulk operations resize at most once and move the elements with a single
+// memcpy/memmove. values must not point into the array itself, use
+// AppendArray(array, array) to duplicate an array's contents
+bool PushMany(D_array* array, const int32_t* values, uint32_t count);
+bool AppendArray(D_array* array, D_array* other);
+bool InsertRange(D_array* array, uint32_t position, const int32_t* values, uint32_t count);
+bool EraseRange(D_array* array, uint32_t position, uint32_t count);
+// grows with copies of fill, or drops the elements past size
+bool Resize(D_array* array, uint32_t size, int32_t fill);
 
+bool _needsToResize(D_array* array);
+bool _needsToShrink(D_array* array);
+uint32_t _grownCapacity(D_array* array);
+bool _resize(D_array* array, uint32_t newCapacity);
+bool _makeRoomFor(D_array* array, uint32_t count);
+void _shrinkIfNeeded(D_array* array);
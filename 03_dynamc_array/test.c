@@ -3,6 +3,12 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include "dynamic_array.h"
+#include "array_kernels.h"
+#include "array_sort.h"
+#include "work_deque.h"
+
+#define THIEVES 3
+#define DEQUE_ITEMS 200000
 
 void _cleanup(D_array* array) {
     DestroyDynamicArray(&array);
@@ -12,20 +18,24 @@ void _cleanup(D_array* array) {
 void _testHappyPath(uint32_t capacity) {
     D_array* array = CreateDynamicArray(capacity);
     int32_t i = 0;
-    while ((array->size + 1) * 2 < array->capacity) {
+    while (array->size < array->capacity) {
         Push(array, i);
         i++;
     }
     assert(array->capacity == capacity);
     Push(array, i);
-    assert(array->capacity == capacity * 2);
+    assert(array->capacity == (uint32_t)(capacity * DEFAULT_GROWTH_FACTOR));
     int32_t* returnValue = (int32_t*)malloc(sizeof(int32_t));
 
     while (!IsEmpty(array)) {
         Pop(array, returnValue);
         assert(*returnValue == (int32_t)array->size);
+        // popping shrinks the array, but never below what it holds
+        assert(array->capacity >= array->size);
     }
     assert(IsEmpty(array) == true);
+    assert(array->capacity < capacity);
+    free(returnValue);
     _cleanup(array);
 }
 
@@ -39,7 +49,395 @@ void TestHappyPath() {
     }
 }
 
+void TestShrinkHysteresis() {
+    D_array* array = CreateDynamicArray(1000);
+    int32_t i, value;
+    for (i = 0; i < 1000; i++) {
+        Push(array, i);
+    }
+    while (array->size > 250) {
+        Pop(array, &value);
+    }
+    assert(array->capacity == 1000);
+    Pop(array, &value);
+    uint32_t shrunk = array->capacity;
+    assert(shrunk == (uint32_t)(249 * DEFAULT_GROWTH_FACTOR));
+
+    // going back and forth around the threshold does not resize again
+    for (i = 0; i < 100; i++) {
+        Push(array, i);
+        Pop(array, &value);
+        assert(array->capacity == shrunk);
+    }
+    _cleanup(array);
+
+    D_array* noShrink = CreateDynamicArrayWithPolicy(16, 2, 0);
+    for (i = 0; i < 1000; i++) {
+        Push(noShrink, i);
+    }
+    uint32_t grown = noShrink->capacity;
+    assert(grown == 1024);
+    while (!IsEmpty(noShrink)) {
+        Pop(noShrink, &value);
+    }
+    assert(noShrink->capacity == grown);
+    _cleanup(noShrink);
+}
+
+void TestReserveAndShrinkToFit() {
+    D_array* array = CreateDynamicArray(10);
+    assert(Reserve(array, 5) == true);
+    assert(array->capacity == 10);
+    assert(Reserve(array, 100000) == true);
+    assert(array->capacity == 100000);
+    int32_t i, value;
+    for (i = 0; i < 100000; i++) {
+        Push(array, i);
+    }
+    assert(array->capacity == 100000);
+    for (i = 0; i < 10; i++) {
+        Pop(array, &value);
+    }
+    assert(ShrinkToFit(array) == true);
+    assert(array->capacity == array->size);
+    assert(array->collection[array->size - 1] == (int32_t)array->size - 1);
+    _cleanup(array);
+
+    // popping does not give back what was reserved, until ShrinkToFit
+    array = CreateDynamicArray(10);
+    assert(Reserve(array, 100000) == true);
+    for (i = 0; i < 10; i++) {
+        Push(array, i);
+    }
+    Pop(array, &value);
+    assert(array->capacity == 100000);
+    assert(EraseRange(array, 0, 8) == true);
+    assert(Resize(array, 0, 0) == true);
+    assert(array->capacity == 100000);
+    assert(ShrinkToFit(array) == true);
+    assert(array->capacity == 1);
+    Push(array, 1);
+    Push(array, 2);
+    Pop(array, &value);
+    Pop(array, &value);
+    assert(array->capacity < 100000);
+    _cleanup(array);
+}
+
+void TestPolicyValidation() {
+    assert(CreateDynamicArrayWithPolicy(10, 1, 0) == NULL);
+    assert(CreateDynamicArrayWithPolicy(10, 2, 0.5f) == NULL);
+    assert(CreateDynamicArrayWithPolicy(10, 1.5f, -1) == NULL);
+    D_array* array = CreateDynamicArray(0);
+    assert(array->capacity == MIN_CAPACITY);
+    assert(DestroyDynamicArray(&array) == true);
+    assert(array == NULL);
+    assert(DestroyDynamicArray(&array) == false);
+}
+
+void _assertContents(D_array* array, const int32_t* expected, uint32_t len) {
+    uint32_t i;
+    assert(array->size == len);
+    for (i = 0; i < len; i++) {
+        assert(array->collection[i] == expected[i]);
+    }
+}
+
+void TestBulkOperations() {
+    D_array* array = CreateDynamicArray(MIN_CAPACITY);
+    int32_t values[] = { 1, 2, 3, 4, 5, 6 };
+    assert(PushMany(array, values, 6) == true);
+    // a batch bigger than one growth step resizes straight to what it needs
+    assert(array->capacity == 6);
+    _assertContents(array, values, 6);
+    assert(PushMany(array, NULL, 0) == true);
+
+    int32_t middle[] = { 10, 11 };
+    assert(InsertRange(array, 2, middle, 2) == true);
+    int32_t inserted[] = { 1, 2, 10, 11, 3, 4, 5, 6 };
+    _assertContents(array, inserted, 8);
+    assert(InsertRange(array, 8, middle, 1) == true);
+    assert(InsertRange(array, 0, middle + 1, 1) == true);
+    int32_t atEnds[] = { 11, 1, 2, 10, 11, 3, 4, 5, 6, 10 };
+    _assertContents(array, atEnds, 10);
+    assert(InsertRange(array, 11, middle, 1) == false);
+
+    assert(EraseRange(array, 3, 2) == true);
+    int32_t erased[] = { 11, 1, 2, 3, 4, 5, 6, 10 };
+    _assertContents(array, erased, 8);
+    assert(EraseRange(array, 7, 2) == false);
+    assert(EraseRange(array, 8, 0) == true);
+    assert(EraseRange(array, 0, 8) == true);
+    assert(IsEmpty(array) == true);
+    assert(array->capacity == MIN_CAPACITY);
+
+    assert(PushMany(array, values, 3) == true);
+    assert(AppendArray(array, array) == true);
+    int32_t doubled[] = { 1, 2, 3, 1, 2, 3 };
+    _assertContents(array, doubled, 6);
+    D_array* other = CreateDynamicArray(MIN_CAPACITY);
+    assert(AppendArray(other, array) == true);
+    _assertContents(other, doubled, 6);
+    _cleanup(other);
+    _cleanup(array);
+}
+
+void TestResize() {
+    D_array* array = CreateDynamicArray(MIN_CAPACITY);
+    assert(Resize(array, 1000, 7) == true);
+    assert(array->size == 1000 && array->capacity == 1000);
+    assert(array->collection[0] == 7 && array->collection[999] == 7);
+    assert(Resize(array, 1200, 0) == true);
+    assert(array->collection[999] == 7 && array->collection[1000] == 0 && array->collection[1199] == 0);
+    // dropping most of the elements goes through the shrink policy
+    assert(Resize(array, 10, 0) == true);
+    assert(array->size == 10);
+    assert(array->capacity == (uint32_t)(10 * DEFAULT_GROWTH_FACTOR));
+    assert(array->collection[9] == 7);
+    _cleanup(array);
+}
+
+void _testKernelsAgainstScalar(D_array* array) {
+    uint32_t index, expectedIndex;
+    int32_t probes[] = { 0, 3, -7, INT32_MAX, INT32_MIN };
+    int i;
+    for (i = 0; i < 5; i++) {
+        bool found = _findScalar(array->collection, array->size, probes[i], &expectedIndex);
+        assert(FindValue(array, probes[i], &index) == found);
+        assert(!found || index == expectedIndex);
+        assert(CountValue(array, probes[i]) == _countScalar(array->collection, array->size, probes[i]));
+    }
+    assert(SumArray(array) == _sumScalar(array->collection, array->size));
+
+    int32_t min, max;
+    assert(MinMaxArray(array, &min, &max) == (array->size > 0));
+    if (array->size > 0) {
+        int32_t expectedMin = array->collection[0], expectedMax = array->collection[0];
+        _minMaxScalar(array->collection, array->size, &expectedMin, &expectedMax);
+        assert(min == expectedMin && max == expectedMax);
+    }
+
+    D_array* filtered = FilterInRange(array, -5, 5);
+    int32_t* expected = malloc((array->size + 1) * sizeof(int32_t));
+    uint32_t kept = _filterScalar(array->collection, array->size, -5, 5, expected);
+    _assertContents(filtered, expected, kept);
+    free(expected);
+    _cleanup(filtered);
+}
+
+void TestKernels() {
+    KernelLevel best = DetectKernelLevel();
+    assert(ActiveKernelLevel() == best);
+    int level;
+    for (level = KERNELS_SCALAR; level <= (int)best; level++) {
+        assert(UseKernelLevel(level) == true);
+        unsigned int state = 777;
+        uint32_t len;
+        // every length up to a few vectors, so every tail size is covered
+        for (len = 0; len < 100; len++) {
+            D_array* array = CreateDynamicArray(len);
+            uint32_t i;
+            for (i = 0; i < len; i++) {
+                state = state * 1103515245 + 12345;
+                Push(array, (int32_t)(state >> 16) % 21 - 10);
+            }
+            if (len > 50) {
+                array->collection[len - 1] = INT32_MAX;
+                array->collection[len - 2] = INT32_MIN;
+            }
+            _testKernelsAgainstScalar(array);
+            _cleanup(array);
+        }
+    }
+    assert(UseKernelLevel(best) == true);
+
+    // the sum of large values does not wrap around 32 bits
+    D_array* large = CreateDynamicArray(MIN_CAPACITY);
+    assert(Resize(large, 1000, INT32_MAX) == true);
+    assert(SumArray(large) == (int64_t)INT32_MAX * 1000);
+    uint32_t index;
+    assert(FindValue(large, 0, &index) == false);
+    large->collection[999] = 0;
+    assert(FindValue(large, 0, &index) == true && index == 999);
+    _cleanup(large);
+}
+
+int _compareInt32(const void* a, const void* b) {
+    int32_t x = *(const int32_t*)a, y = *(const int32_t*)b;
+    return (x > y) - (x < y);
+}
+
+// sorted, reverse sorted, random and few unique values
+void _fillPattern(D_array* array, uint32_t len, int pattern) {
+    unsigned int state = 99 + len;
+    uint32_t i;
+    array->size = 0;
+    for (i = 0; i < len; i++) {
+        state = state * 1103515245 + 12345;
+        int32_t value = pattern == 0 ? (int32_t)i - 1000
+            : pattern == 1 ? (int32_t)(len - i) * 3
+            : pattern == 2 ? (int32_t)(state ^ (state << 16))
+            : (int32_t)(state >> 16) % 4 - 2;
+        Push(array, value);
+    }
+}
+
+void TestSorts() {
+    uint32_t lengths[] = { 0, 1, 2, 15, 17, 100, 1000, 300000 };
+    int lengthCount = sizeof(lengths) / sizeof(lengths[0]), l, pattern, sort;
+    D_array* expected = CreateDynamicArray(MIN_CAPACITY);
+    D_array* array = CreateDynamicArray(MIN_CAPACITY);
+    for (l = 0; l < lengthCount; l++) {
+        for (pattern = 0; pattern < 4; pattern++) {
+            _fillPattern(expected, lengths[l], pattern);
+            qsort(expected->collection, expected->size, sizeof(int32_t), _compareInt32);
+            for (sort = 0; sort < 4; sort++) {
+                _fillPattern(array, lengths[l], pattern);
+                if (sort == 0) assert(RadixSort(array) == true);
+                if (sort == 1) IntroSort(array);
+                // 3 threads leave a run without a partner in the first merge round
+                if (sort == 2) assert(ParallelSort(array, 3) == true);
+                if (sort == 3) assert(ParallelSort(array, 4) == true);
+                assert(IsSorted(array) == true);
+                _assertContents(array, expected->collection, expected->size);
+            }
+        }
+    }
+    // a heapsort fallback must give the same result
+    _fillPattern(array, 1000, 2);
+    _heapSort(array->collection, array->size);
+    assert(IsSorted(array) == true);
+    _cleanup(array);
+    _cleanup(expected);
+}
+
+void TestBounds() {
+    int32_t values[] = { -5, 1, 1, 1, 4, 9, 9 };
+    D_array* array = CreateDynamicArray(MIN_CAPACITY);
+    assert(LowerBound(array, 3) == 0 && UpperBound(array, 3) == 0);
+    PushMany(array, values, 7);
+    assert(LowerBound(array, -10) == 0 && UpperBound(array, -10) == 0);
+    assert(LowerBound(array, -5) == 0 && UpperBound(array, -5) == 1);
+    assert(LowerBound(array, 1) == 1 && UpperBound(array, 1) == 4);
+    assert(LowerBound(array, 2) == 4 && UpperBound(array, 2) == 4);
+    assert(LowerBound(array, 9) == 5 && UpperBound(array, 9) == 7);
+    assert(LowerBound(array, 10) == 7 && UpperBound(array, 10) == 7);
+    _cleanup(array);
+}
+
+void _testWorkDequeSingleThread() {
+    WorkDeque* deque = CreateWorkDeque(0);
+    assert(atomic_load(&deque->buffer)->mask + 1 == WORK_DEQUE_MIN_CAPACITY);
+    void* item;
+    assert(DequePop(deque, &item) == false);
+    assert(DequeSteal(deque, &item) == STEAL_EMPTY);
+    uintptr_t i;
+    // three times the capacity, so it grows twice
+    for (i = 1; i <= 3 * WORK_DEQUE_MIN_CAPACITY; i++) {
+        assert(DequePush(deque, (void*)i) == true);
+    }
+    assert(DequeSize(deque) == 3 * WORK_DEQUE_MIN_CAPACITY);
+    assert(atomic_load(&deque->buffer)->mask + 1 == 4 * WORK_DEQUE_MIN_CAPACITY);
+    assert(atomic_load(&deque->buffer)->previous->previous != NULL);
+    // the owner takes the newest and thieves the oldest
+    assert(DequePop(deque, &item) == true && (uintptr_t)item == 3 * WORK_DEQUE_MIN_CAPACITY);
+    assert(DequeSteal(deque, &item) == STEAL_SUCCESS && (uintptr_t)item == 1);
+    for (i = 2; i < 3 * WORK_DEQUE_MIN_CAPACITY; i++) {
+        assert(DequeSteal(deque, &item) == STEAL_SUCCESS && (uintptr_t)item == i);
+    }
+    assert(DequeSize(deque) == 0);
+    assert(DequePop(deque, &item) == false);
+    assert(DequeSteal(deque, &item) == STEAL_EMPTY);
+    // positions keep moving forward around the ring
+    for (i = 1; i <= 5; i++) {
+        assert(DequePush(deque, (void*)i) == true);
+    }
+    for (i = 5; i >= 1; i--) {
+        assert(DequePop(deque, &item) == true && (uintptr_t)item == i);
+    }
+    DestroyWorkDeque(&deque);
+    assert(deque == NULL);
+}
+
+typedef struct {
+    WorkDeque* deque;
+    _Atomic bool* done;
+    uint8_t* seen;
+} Thief;
+
+void* _steal(void* arg) {
+    Thief* thief = arg;
+    void* item;
+    for (;;) {
+        bool done = atomic_load(thief->done);
+        StealResult result = DequeSteal(thief->deque, &item);
+        if (result == STEAL_SUCCESS) {
+            __atomic_fetch_add(&thief->seen[(uintptr_t)item], 1, __ATOMIC_RELAXED);
+        } else if (result == STEAL_EMPTY && done) {
+            return NULL;
+        }
+    }
+}
+
+void _testWorkDequeWithThieves() {
+    // starts small, so it grows while the thieves steal
+    WorkDeque* deque = CreateWorkDeque(WORK_DEQUE_MIN_CAPACITY);
+    uint8_t* seen = calloc(DEQUE_ITEMS, 1);
+    _Atomic bool done = false;
+    Thief thieves[THIEVES];
+    pthread_t threads[THIEVES];
+    int t;
+    for (t = 0; t < THIEVES; t++) {
+        thieves[t].deque = deque;
+        thieves[t].done = &done;
+        thieves[t].seen = seen;
+        pthread_create(&threads[t], NULL, _steal, &thieves[t]);
+    }
+    void* item;
+    uintptr_t i;
+    for (i = 0; i < DEQUE_ITEMS; i++) {
+        assert(DequePush(deque, (void*)i) == true);
+        // pop now and then, so the owner races the thieves for the bottom
+        if (i % 3 == 0) {
+            item = (void*)UINTPTR_MAX;
+            if (DequePop(deque, &item)) {
+                __atomic_fetch_add(&seen[(uintptr_t)item], 1, __ATOMIC_RELAXED);
+            } else {
+                // a pop that lost the last item to a thief must not hand it out
+                assert(item == (void*)UINTPTR_MAX);
+            }
+        }
+    }
+    while (DequePop(deque, &item)) {
+        __atomic_fetch_add(&seen[(uintptr_t)item], 1, __ATOMIC_RELAXED);
+    }
+    atomic_store(&done, true);
+    for (t = 0; t < THIEVES; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    // every item was taken exactly once, by the owner or by a thief
+    for (i = 0; i < DEQUE_ITEMS; i++) {
+        assert(seen[i] == 1);
+    }
+    free(seen);
+    DestroyWorkDeque(&deque);
+}
+
+void TestWorkDeque() {
+    _testWorkDequeSingleThread();
+    _testWorkDequeWithThieves();
+}
+
 int main(void) {
     TestHappyPath();
+    TestShrinkHysteresis();
+    TestReserveAndShrinkToFit();
+    TestPolicyValidation();
+    TestBulkOperations();
+    TestResize();
+    TestKernels();
+    TestSorts();
+    TestBounds();
+    TestWorkDeque();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "work_deque.h"
+
+DequeBuffer* _createDequeBuffer(size_t capacity) {
+    if (capacity > (SIZE_MAX - sizeof(DequeBuffer)) / sizeof(void*)) {
+        return NULL;
+    }
+    DequeBuffer* buffer = malloc(sizeof(DequeBuffer) + capacity * sizeof(void*));
+    if (buffer == NULL) {
+        return NULL;
+    }
+    buffer->mask = capacity - 1;
+    buffer->previous = NULL;
+    return buffer;
+}
+
+WorkDeque* CreateWorkDeque(size_t capacity) {
+    size_t rounded = WORK_DEQUE_MIN_CAPACITY;
+    while (rounded < capacity) {
+        if (rounded > SIZE_MAX / 2) {
+            return NULL;
+        }
+        rounded *= 2;
+    }
+    WorkDeque* deque = aligned_alloc(CACHE_LINE_SIZE, sizeof(WorkDeque));
+    if (deque == NULL) {
+        return NULL;
+    }
+    DequeBuffer* buffer = _createDequeBuffer(rounded);
+    if (buffer == NULL) {
+        free(deque);
+        return NULL;
+    }
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    atomic_init(&deque->buffer, buffer);
+    return deque;
+}
+
+void DestroyWorkDeque(WorkDeque** dequep) {
+    WorkDeque* deque = *dequep;
+    if (deque == NULL) {
+        return;
+    }
+    DequeBuffer* buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+    while (buffer != NULL) {
+        DequeBuffer* previous = buffer->previous;
+        free(buffer);
+        buffer = previous;
+    }
+    free(deque);
+    *dequep = NULL;
+}
+
+// copies the live positions into a buffer twice as big. Positions keep their
+// numbers, so thieves that already read top only see a different buffer
+DequeBuffer* _growDeque(WorkDeque* deque, DequeBuffer* buffer, int64_t top, int64_t bottom) {
+    size_t capacity = buffer->mask + 1;
+    if (capacity > SIZE_MAX / 2) {
+        return NULL;
+    }
+    DequeBuffer* grown = _createDequeBuffer(capacity * 2);
+    if (grown == NULL) {
+        return NULL;
+    }
+    int64_t i;
+    for (i = top; i < bottom; i++) {
+        void* item = atomic_load_explicit(&buffer->items[i & buffer->mask], memory_order_relaxed);
+        atomic_store_explicit(&grown->items[i & grown->mask], item, memory_order_relaxed);
+    }
+    grown->previous = buffer;
+    // release, so a thief that loads the new buffer also sees the copies
+    atomic_store_explicit(&deque->buffer, grown, memory_order_release);
+    return grown;
+}
+
+bool DequePush(WorkDeque* deque, void* item) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    DequeBuffer* buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+    if ((size_t)(bottom - top) > buffer->mask) {
+        buffer = _growDeque(deque, buffer, top, bottom);
+        if (buffer == NULL) {
+            return false;
+        }
+    }
+    atomic_store_explicit(&buffer->items[bottom & buffer->mask], item, memory_order_relaxed);
+    // the item is written before thieves can see the new bottom
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return true;
+}
+
+bool DequePop(WorkDeque* deque, void** item) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    DequeBuffer* buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+    // claim the bottom item first, then look at top. The full fence keeps a
+    // thief from reading the old bottom after we read its old top
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    if (top > bottom) {
+        // it was empty
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return false;
+    }
+    void* popped = atomic_load_explicit(&buffer->items[bottom & buffer->mask], memory_order_relaxed);
+    if (top < bottom) {
+        // more than one item left, no thief can reach this one
+        *item = popped;
+        return true;
+    }
+    // the last item, race the thieves for it through top. When a thief wins,
+    // the item is the thief's and the caller's variable is left alone
+    bool won = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+        memory_order_seq_cst, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    if (won) {
+        *item = popped;
+    }
+    return won;
+}
+
+StealResult DequeSteal(WorkDeque* deque, void** item) {
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if (top >= bottom) {
+        return STEAL_EMPTY;
+    }
+    DequeBuffer* buffer = atomic_load_explicit(&deque->buffer, memory_order_acquire);
+    void* stolen = atomic_load_explicit(&buffer->items[top & buffer->mask], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+        memory_order_seq_cst, memory_order_relaxed)) {
+        return STEAL_LOST_RACE;
+    }
+    *item = stolen;
+    return STEAL_SUCCESS;
+}
+
+size_t DequeSize(WorkDeque* deque) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    return bottom > top ? (size_t)(bottom - top) : 0;
+}
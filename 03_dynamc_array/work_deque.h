@@ -0,0 +1,46 @@
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define CACHE_LINE_SIZE 64
+#define WORK_DEQUE_MIN_CAPACITY 16
+
+// a circular array: position i lives at items[i & mask]. When the deque
+// grows, the old buffer stays alive in the previous chain, since a thief may
+// still be reading from it, and the whole chain is freed with the deque
+typedef struct DequeBuffer_T {
+    size_t mask;
+    struct DequeBuffer_T* previous;
+    _Atomic(void*) items[];
+} DequeBuffer;
+
+typedef enum { STEAL_SUCCESS, STEAL_EMPTY, STEAL_LOST_RACE } StealResult;
+
+// a Chase-Lev work stealing deque of void*, with the C11 orderings of
+// Le, Pop, Cohen and Zappa Nardelli. One thread owns it and pushes and pops
+// at the bottom, like a stack, while any other thread may steal from the
+// top. The owner only competes with thieves for the last item
+typedef struct {
+    _Alignas(CACHE_LINE_SIZE) _Atomic int64_t top;
+    _Alignas(CACHE_LINE_SIZE) _Atomic int64_t bottom;
+    _Atomic(DequeBuffer*) buffer;
+} WorkDeque;
+
+// capacity is rounded up to a power of two, and doubles when it is full
+WorkDeque* CreateWorkDeque(size_t capacity);
+// no thread may be using the deque anymore
+void DestroyWorkDeque(WorkDeque** dequep);
+// owner only. false when growing fails, the deque is left as it was
+bool DequePush(WorkDeque* deque, void* item);
+// owner only, takes the newest item
+bool DequePop(WorkDeque* deque, void** item);
+// any thread, takes the oldest item. STEAL_LOST_RACE means another thread
+// took it first and there may be more to steal
+StealResult DequeSteal(WorkDeque* deque, void** item);
+// only a hint while other threads steal
+size_t DequeSize(WorkDeque* deque);
+
+DequeBuffer* _createDequeBuffer(size_t capacity);
+DequeBuffer* _growDeque(WorkDeque* deque, DequeBuffer* buffer, int64_t top, int64_t bottom);
@@ -0,0 +1,76 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "checker.h"
+#include "streamChecker.h"
+
+#define BENCH_SIZE (256u << 20)
+#define SHORT_STRINGS 1000000
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// something that looks like source code: mostly text, a few nested
+// calls and brackets, and a literal with a bracket inside
+char* _generateInput(size_t len) {
+    char* input = malloc(len + 1);
+    char* pattern = "result[i] = compute(alpha, (beta + gamma) * delta(\"eps)\"));\n";
+    size_t patternLen = strlen(pattern);
+    size_t i;
+    for (i = 0; i + patternLen <= len; i += patternLen) {
+        memcpy(input + i, pattern, patternLen);
+    }
+    memset(input + i, ' ', len - i);
+    input[len] = '\0';
+    return input;
+}
+
+int main(void) {
+    // build with -DLIBRARY_LOGGING to see what a message per call costs
+    char* shortInput = "while (index[i] != end) { step(index, i); }";
+    int i, balancedCount = 0;
+    double start = _nowSeconds();
+    for (i = 0; i < SHORT_STRINGS; i++) {
+        balancedCount += IsABalancedString(shortInput);
+    }
+    double shortTime = _nowSeconds() - start;
+#ifdef LIBRARY_LOGGING
+    printf("%d short strings, logging on:  %7.1f ns/string\n", balancedCount, shortTime * 1e9 / SHORT_STRINGS);
+#else
+    printf("%d short strings, logging off: %7.1f ns/string\n", balancedCount, shortTime * 1e9 / SHORT_STRINGS);
+#endif
+
+    char* input = _generateInput(BENCH_SIZE);
+    printf("%u MiB of input\n", BENCH_SIZE >> 20);
+
+    start = _nowSeconds();
+    bool balanced = IsABalancedStringWith(input, &SOURCE_DELIMITERS, NULL);
+    double stackTime = _nowSeconds() - start;
+    printf("  CheckBalance       %7.2f GB/s  (%s)\n", BENCH_SIZE / stackTime / 1e9, balanced ? "balanced" : "unbalanced");
+
+    uint64_t offset;
+    start = _nowSeconds();
+    balanced = IsABalancedBuffer(input, BENCH_SIZE, &SOURCE_DELIMITERS, &offset);
+    double streamTime = _nowSeconds() - start;
+    printf("  IsABalancedBuffer  %7.2f GB/s  (%s)\n", BENCH_SIZE / streamTime / 1e9, balanced ? "balanced" : "unbalanced");
+
+    // the speedup can only show up to the number of cores of the machine
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int maxThreads = cores > 8 ? cores : 8;
+    unsigned int threads;
+    for (threads = 1; threads <= maxThreads; threads *= 2) {
+        start = _nowSeconds();
+        balanced = IsABalancedBufferParallel(input, BENCH_SIZE, &SOURCE_DELIMITERS, threads, &offset);
+        double parallelTime = _nowSeconds() - start;
+        printf("  %2u threads         %7.2f GB/s  speedup %5.2fx  (%s)\n", threads, BENCH_SIZE / parallelTime / 1e9,
+            streamTime / parallelTime, balanced ? "balanced" : "unbalanced");
+    }
+
+    free(input);
+    return 0;
+}
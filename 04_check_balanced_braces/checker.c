@@ -1,49 +1,153 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <stdbool.h>
-#include "stringStack.h"
+#include "checker.h"
 
-const int OPEN_BRACE = '(';
-const int CLOSING_BRACE = ')';
-const int END_OF_STRING = 0;
+const DelimiterSet DEFAULT_DELIMITERS = { {
+    ['('] = DELIMITER_OPENER | 0, [')'] = DELIMITER_CLOSER | 0,
+    ['['] = DELIMITER_OPENER | 1, [']'] = DELIMITER_CLOSER | 1,
+    ['{'] = DELIMITER_OPENER | 2, ['}'] = DELIMITER_CLOSER | 2,
+    ['<'] = DELIMITER_OPENER | 3, ['>'] = DELIMITER_CLOSER | 3,
+} };
+
+const DelimiterSet SOURCE_DELIMITERS = { {
+    ['('] = DELIMITER_OPENER | 0, [')'] = DELIMITER_CLOSER | 0,
+    ['['] = DELIMITER_OPENER | 1, [']'] = DELIMITER_CLOSER | 1,
+    ['{'] = DELIMITER_OPENER | 2, ['}'] = DELIMITER_CLOSER | 2,
+    ['"'] = DELIMITER_QUOTE, ['\''] = DELIMITER_QUOTE,
+    ['\\'] = DELIMITER_ESCAPE,
+} };
+
+const char* CheckStatusString(CheckStatus status) {
+    switch (status) {
+    case CHECK_BALANCED: return "balanced";
+    case CHECK_UNMATCHED_CLOSER: return "closing delimiter without a matching opener";
+    case CHECK_UNCLOSED: return "input ended with delimiters or quotes still open";
+    case CHECK_BAD_ARGUMENT: return "bad values provided";
+    case CHECK_NO_MEMORY: return "could not allocate the stack";
+    }
+    return "unknown status";
+}
+
+bool InitDelimiterSet(DelimiterSet* set, const char* pairs, const char* quotes, char escape) {
+    if (set == NULL || pairs == NULL) {
+        LOG("error: bad values provided");
+        return false;
+    }
+    size_t pairsLen = strlen(pairs);
+    if (pairsLen % 2 != 0 || pairsLen / 2 > MAX_DELIMITER_PAIRS) {
+        LOG("error: delimiters must be given as pairs, at most %d of them", MAX_DELIMITER_PAIRS);
+        return false;
+    }
+    memset(set->classes, 0, sizeof(set->classes));
+    size_t i;
+    for (i = 0; i < pairsLen; i += 2) {
+        uint8_t opener = pairs[i];
+        uint8_t closer = pairs[i + 1];
+        if (opener == closer || set->classes[opener] != 0 || set->classes[closer] != 0) {
+            LOG("error: delimiter %c%c is ambiguous", opener, closer);
+            return false;
+        }
+        set->classes[opener] = DELIMITER_OPENER | (i / 2);
+        set->classes[closer] = DELIMITER_CLOSER | (i / 2);
+    }
+    for (i = 0; quotes != NULL && quotes[i] != 0; i++) {
+        if (set->classes[(uint8_t)quotes[i]] != 0) {
+            LOG("error: quote %c is already a delimiter", quotes[i]);
+            return false;
+        }
+        set->classes[(uint8_t)quotes[i]] = DELIMITER_QUOTE;
+    }
+    if (escape != 0) {
+        if (set->classes[(uint8_t)escape] != 0) {
+            LOG("error: escape %c is already a delimiter", escape);
+            return false;
+        }
+        set->classes[(uint8_t)escape] = DELIMITER_ESCAPE;
+    }
+    return true;
+}
 
 bool IsABalancedString(char* input) {
-    int stringLength = 0;
-    while (input[stringLength] != END_OF_STRING) {
-        stringLength++;
+    if (IsABalancedStringWith(input, &DEFAULT_DELIMITERS, NULL)) {
+        LOG("the string was balanced");
+        return true;
     }
+    LOG("the string was unbalanced");
+    return false;
+}
+
+bool IsABalancedStringWith(char* input, const DelimiterSet* set, size_t* errorOffset) {
+    return CheckBalance(input, set, errorOffset) == CHECK_BALANCED;
+}
+
+CheckStatus CheckBalance(char* input, const DelimiterSet* set, size_t* errorOffset) {
+    if (input == NULL || set == NULL) {
+        LOG("error: bad values provided");
+        return CHECK_BAD_ARGUMENT;
+    }
+    size_t stringLength = strlen(input);
     if (stringLength == 0) {
-        printf("empty string provided");
-        return true;
+        return CHECK_BALANCED;
     }
-    Stack* stack = CreateNewStack(stringLength);
-    int i = 0;
-    for (i = 0; i < stringLength; i++) {
-        if (input[i] == OPEN_BRACE) {
-            Push(stack, input[i]);
+    // only openers are pushed, each as the index of its pair, and the
+    // stack only grows past its inline items for deeply nested input
+    DelimiterStack stack;
+    DelimiterStackInit(&stack);
+    const uint8_t* classes = set->classes;
+    size_t failedAt = stringLength;
+    CheckStatus status = CHECK_BALANCED;
+    size_t i, j;
+    for (i = 0; i < stringLength && status == CHECK_BALANCED; i++) {
+        uint8_t class = classes[(uint8_t)input[i]];
+        if (class == 0) {
             continue;
         }
-        if (input[i] == CLOSING_BRACE) {
-            int item = 0;
-            Peek(stack, &item);
-
-            if (item == OPEN_BRACE) {
-                Pop(stack, &item);
-                continue;
+        uint8_t item = 0;
+        switch (class & DELIMITER_KIND_MASK) {
+        case DELIMITER_OPENER:
+            // with more openers than bytes left to close them
+            // the string can not be balanced anymore
+            if (stack.size >= stringLength - i - 1) {
+                status = CHECK_UNCLOSED;
+                break;
             }
-
-            Push(stack, input[i]);
+            if (!DelimiterStackPush(&stack, class & DELIMITER_PAIR_MASK)) {
+                LOG("error: could not grow the stack");
+                status = CHECK_NO_MEMORY;
+            }
+            break;
+        case DELIMITER_CLOSER:
+            if (!DelimiterStackPop(&stack, &item) || item != (class & DELIMITER_PAIR_MASK)) {
+                failedAt = i;
+                status = CHECK_UNMATCHED_CLOSER;
+            }
+            break;
+        case DELIMITER_ESCAPE:
+            i++;
+            break;
+        case DELIMITER_QUOTE:
+            // inside a literal only the escape and the closing quote matter
+            for (j = i + 1; j < stringLength && input[j] != input[i]; j++) {
+                if (classes[(uint8_t)input[j]] == DELIMITER_ESCAPE) {
+                    j++;
+                }
+            }
+            if (j >= stringLength) {
+                status = CHECK_UNCLOSED;
+            }
+            i = j;
+            break;
         }
     }
-
-    int finalSize = stack->size;
-    DestroyStack(&stack);
-
-    if (finalSize == 0) {
-        printf("the string was balanced\n");
-        return true;
+    if (status == CHECK_BALANCED && !DelimiterStackIsEmpty(&stack)) {
+        status = CHECK_UNCLOSED;
     }
-    printf("the string was unbalanced\n");
-    return false;
+    DelimiterStackDestroy(&stack);
+    if (status != CHECK_BALANCED && errorOffset != NULL) {
+        *errorOffset = failedAt;
+    }
+    return status;
 }
@@ -1 +1,51 @@
-bool IsABalancedString(char* input);
\ No newline at end of file
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "log.h"
+#include "generic_stack.h"
+
+#define MAX_DELIMITER_PAIRS 32
+// each byte has a class: the top bits say what kind of delimiter it is,
+// and for brackets the low bits hold the index of its pair
+#define DELIMITER_OPENER 0x20
+#define DELIMITER_CLOSER 0x40
+#define DELIMITER_QUOTE 0x60
+#define DELIMITER_ESCAPE 0x80
+#define DELIMITER_KIND_MASK 0xE0
+#define DELIMITER_PAIR_MASK 0x1F
+// strings nested at most this deep are checked without allocating
+#define CHECK_INLINE_DEPTH 256
+
+// holds the pair index of every opener that is still open
+DEFINE_SMALL_STACK(DelimiterStack, uint8_t, CHECK_INLINE_DEPTH)
+
+typedef enum {
+    CHECK_BALANCED,
+    CHECK_UNMATCHED_CLOSER,
+    CHECK_UNCLOSED,
+    CHECK_BAD_ARGUMENT,
+    CHECK_NO_MEMORY,
+} CheckStatus;
+
+typedef struct {
+    uint8_t classes[256];
+} DelimiterSet;
+
+// ()[]{}<>
+extern const DelimiterSet DEFAULT_DELIMITERS;
+// ()[]{} outside of "..." and '...' literals, with \ as escape
+extern const DelimiterSet SOURCE_DELIMITERS;
+
+// pairs holds opener/closer pairs back to back, like "()[]", quotes the
+// characters that open and close a literal, escape may be 0 for none
+bool InitDelimiterSet(DelimiterSet* set, const char* pairs, const char* quotes, char escape);
+
+const char* CheckStatusString(CheckStatus status);
+
+bool IsABalancedString(char* input);
+// stops at the first closer that can not match, errorOffset receives its
+// offset, or the length of the input when it ends with something still open
+CheckStatus CheckBalance(char* input, const DelimiterSet* set, size_t* errorOffset);
+bool IsABalancedStringWith(char* input, const DelimiterSet* set, size_t* errorOffset);
+
@@ -0,0 +1,342 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#include "checker.h"
+#include "streamChecker.h"
+
+bool InitStreamChecker(StreamChecker* checker, const DelimiterSet* set) {
+    if (checker == NULL || set == NULL) {
+        LOG("error: bad values provided");
+        return false;
+    }
+    checker->set = set;
+    // the bytes that mean something in this set, compared against whole
+    // blocks at once. With too many of them every byte goes through the table
+    checker->symbolCount = 0;
+    int byte;
+    for (byte = 0; byte < 256; byte++) {
+        if (set->classes[byte] == 0) continue;
+        if (checker->symbolCount == STREAM_MAX_SYMBOLS) {
+            checker->symbolCount = 0;
+            break;
+        }
+        checker->symbols[checker->symbolCount++] = byte;
+    }
+    DelimiterStackInit(&checker->open);
+    DelimiterStackInit(&checker->unmatched);
+    checker->summarizing = false;
+    checker->consumed = 0;
+    checker->outermostOpen = 0;
+    checker->quote = 0;
+    checker->quoteOffset = 0;
+    checker->escaped = false;
+    checker->mismatch = false;
+    checker->mismatchOffset = 0;
+    return true;
+}
+
+void DestroyStreamChecker(StreamChecker* checker) {
+    DelimiterStackDestroy(&checker->open);
+    DelimiterStackDestroy(&checker->unmatched);
+}
+
+// sets bit i when block[i] is an opener, a closer, a quote or an escape
+uint64_t _classifyBlock(StreamChecker* checker, const char* block) {
+    if (checker->symbolCount == 0) {
+        return _classifyTail(checker, block, STREAM_BLOCK_SIZE);
+    }
+    unsigned int s;
+#if defined(__AVX2__)
+    __m256i low = _mm256_loadu_si256((const __m256i*)block);
+    __m256i high = _mm256_loadu_si256((const __m256i*)(block + 32));
+    __m256i lowMatches = _mm256_setzero_si256();
+    __m256i highMatches = _mm256_setzero_si256();
+    for (s = 0; s < checker->symbolCount; s++) {
+        __m256i symbol = _mm256_set1_epi8(checker->symbols[s]);
+        lowMatches = _mm256_or_si256(lowMatches, _mm256_cmpeq_epi8(low, symbol));
+        highMatches = _mm256_or_si256(highMatches, _mm256_cmpeq_epi8(high, symbol));
+    }
+    return (uint32_t)_mm256_movemask_epi8(lowMatches) | (uint64_t)(uint32_t)_mm256_movemask_epi8(highMatches) << 32;
+#elif defined(__SSE2__)
+    uint64_t mask = 0;
+    int i;
+    for (i = 0; i < 4; i++) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(block + i * 16));
+        __m128i matches = _mm_setzero_si128();
+        for (s = 0; s < checker->symbolCount; s++) {
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(checker->symbols[s])));
+        }
+        mask |= (uint64_t)(uint16_t)_mm_movemask_epi8(matches) << (i * 16);
+    }
+    return mask;
+#else
+    (void)s;
+    return _classifyTail(checker, block, STREAM_BLOCK_SIZE);
+#endif
+}
+
+uint64_t _classifyTail(StreamChecker* checker, const char* bytes, size_t len) {
+    const uint8_t* classes = checker->set->classes;
+    uint64_t mask = 0;
+    size_t i;
+    for (i = 0; i < len; i++) {
+        mask |= (uint64_t)(classes[(uint8_t)bytes[i]] != 0) << i;
+    }
+    return mask;
+}
+
+bool _failAt(StreamChecker* checker, uint64_t offset) {
+    checker->mismatch = true;
+    checker->mismatchOffset = offset;
+    return false;
+}
+
+// walks the delimiters of one block in order. Blocks without any are
+// skipped by the caller, which is most of them in text or source code
+bool _applyMask(StreamChecker* checker, const char* bytes, size_t len, uint64_t structural, uint64_t base) {
+    if (checker->escaped && len > 0) {
+        structural &= ~(uint64_t)1;
+        checker->escaped = false;
+    }
+    const uint8_t* classes = checker->set->classes;
+    uint8_t item;
+    while (structural != 0) {
+        unsigned int bit = __builtin_ctzll(structural);
+        structural &= structural - 1;
+        char byte = bytes[bit];
+        uint8_t class = classes[(uint8_t)byte];
+        uint8_t kind = class & DELIMITER_KIND_MASK;
+        if (kind == DELIMITER_ESCAPE) {
+            // the escaped byte may be in the next block
+            if (bit + 1 < len) {
+                structural &= ~((uint64_t)1 << (bit + 1));
+            } else {
+                checker->escaped = true;
+            }
+            continue;
+        }
+        // inside a literal only the escape and the closing quote matter
+        if (checker->quote != 0) {
+            if (byte == checker->quote) {
+                checker->quote = 0;
+            }
+            continue;
+        }
+        switch (kind) {
+        case DELIMITER_QUOTE:
+            checker->quote = byte;
+            checker->quoteOffset = base + bit;
+            break;
+        case DELIMITER_OPENER:
+            if (DelimiterStackIsEmpty(&checker->open)) {
+                checker->outermostOpen = base + bit;
+            }
+            if (!DelimiterStackPush(&checker->open, class & DELIMITER_PAIR_MASK)) {
+                LOG("error: could not grow the stack");
+                return _failAt(checker, base + bit);
+            }
+            break;
+        case DELIMITER_CLOSER:
+            if (!DelimiterStackPop(&checker->open, &item)) {
+                if (!checker->summarizing) {
+                    return _failAt(checker, base + bit);
+                }
+                if (!DelimiterStackPush(&checker->unmatched, class & DELIMITER_PAIR_MASK)) {
+                    LOG("error: could not grow the stack");
+                    return _failAt(checker, base + bit);
+                }
+            } else if (item != (class & DELIMITER_PAIR_MASK)) {
+                return _failAt(checker, base + bit);
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+bool FeedStreamChecker(StreamChecker* checker, const char* chunk, size_t len) {
+    if (checker->mismatch) {
+        return false;
+    }
+    uint64_t structural;
+    size_t i;
+    for (i = 0; i + STREAM_BLOCK_SIZE <= len; i += STREAM_BLOCK_SIZE) {
+        structural = _classifyBlock(checker, chunk + i);
+        if ((structural != 0 || checker->escaped)
+            && !_applyMask(checker, chunk + i, STREAM_BLOCK_SIZE, structural, checker->consumed + i)) {
+            return false;
+        }
+    }
+    structural = _classifyTail(checker, chunk + i, len - i);
+    if (!_applyMask(checker, chunk + i, len - i, structural, checker->consumed + i)) {
+        return false;
+    }
+    checker->consumed += len;
+    return true;
+}
+
+bool FinishStreamChecker(StreamChecker* checker, uint64_t* errorOffset) {
+    if (checker->mismatch) {
+        if (errorOffset != NULL) *errorOffset = checker->mismatchOffset;
+        return false;
+    }
+    // an opener still open came before any literal opened after it
+    if (!DelimiterStackIsEmpty(&checker->open)) {
+        if (errorOffset != NULL) *errorOffset = checker->outermostOpen;
+        return false;
+    }
+    if (checker->quote != 0) {
+        if (errorOffset != NULL) *errorOffset = checker->quoteOffset;
+        return false;
+    }
+    return true;
+}
+
+bool IsABalancedBuffer(const char* input, size_t len, const DelimiterSet* set, uint64_t* errorOffset) {
+    StreamChecker checker;
+    if (!InitStreamChecker(&checker, set)) {
+        return false;
+    }
+    FeedStreamChecker(&checker, input, len);
+    bool balanced = FinishStreamChecker(&checker, errorOffset);
+    DestroyStreamChecker(&checker);
+    return balanced;
+}
+
+bool IsABalancedFile(const char* path, const DelimiterSet* set, uint64_t* errorOffset) {
+    StreamChecker checker;
+    if (!InitStreamChecker(&checker, set)) {
+        return false;
+    }
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        LOG("error: could not open %s", path);
+        return false;
+    }
+    char* buffer = malloc(STREAM_CHUNK_SIZE);
+    if (buffer == NULL) {
+        LOG("error: could not allocate read buffer");
+        fclose(file);
+        return false;
+    }
+    size_t read;
+    while ((read = fread(buffer, 1, STREAM_CHUNK_SIZE, file)) > 0) {
+        if (!FeedStreamChecker(&checker, buffer, read)) {
+            break;
+        }
+    }
+    bool readError = ferror(file);
+    free(buffer);
+    fclose(file);
+    bool balanced = false;
+    if (readError) {
+        LOG("error: could not read %s", path);
+    } else {
+        balanced = FinishStreamChecker(&checker, errorOffset);
+    }
+    DestroyStreamChecker(&checker);
+    return balanced;
+}
+
+// every chunk is summarized as if it started outside of any literal: what
+// is left once its pairs cancel out is some closers that found nothing to
+// close, followed by some openers still open, like ")]}([("
+void* _summarizeChunk(void* arg) {
+    ParallelChunk* chunk = arg;
+    FeedStreamChecker(&chunk->checker, chunk->input, chunk->len);
+    return NULL;
+}
+
+// applies the summary of the next chunk to the checker that went through
+// the chunks before it. Returns false, leaving total as it was, when the
+// chunk has to be fed to total again: it did not start outside of a
+// literal after all, or something in it does not match
+bool _mergeChunk(StreamChecker* total, StreamChecker* chunk) {
+    if (total->quote != 0 || total->escaped || chunk->mismatch) {
+        return false;
+    }
+    uint32_t closers = chunk->unmatched.size;
+    if (closers > total->open.size) {
+        return false;
+    }
+    // the first closer left in the chunk closes the last opener left before it
+    uint32_t i;
+    for (i = 0; i < closers; i++) {
+        if (chunk->unmatched.items[i] != total->open.items[total->open.size - 1 - i]) {
+            return false;
+        }
+    }
+    uint32_t openers = chunk->open.size;
+    if (!DelimiterStackReserve(&total->open, total->open.size - closers + openers)) {
+        return false;
+    }
+    total->open.size -= closers;
+    if (total->open.size == 0 && openers > 0) {
+        total->outermostOpen = chunk->outermostOpen;
+    }
+    memcpy(total->open.items + total->open.size, chunk->open.items, openers);
+    total->open.size += openers;
+    total->quote = chunk->quote;
+    total->quoteOffset = chunk->quoteOffset;
+    total->escaped = chunk->escaped;
+    total->consumed = chunk->consumed;
+    return true;
+}
+
+bool IsABalancedBufferParallel(const char* input, size_t len, const DelimiterSet* set, unsigned int threads,
+    uint64_t* errorOffset) {
+    if (threads > PARALLEL_MAX_THREADS) {
+        threads = PARALLEL_MAX_THREADS;
+    }
+    if (threads > len / PARALLEL_MIN_CHUNK_SIZE) {
+        threads = len / PARALLEL_MIN_CHUNK_SIZE;
+    }
+    if (threads <= 1) {
+        return IsABalancedBuffer(input, len, set, errorOffset);
+    }
+
+    ParallelChunk chunks[PARALLEL_MAX_THREADS];
+    size_t chunkLen = len / threads;
+    unsigned int i, started;
+    for (i = 0; i < threads; i++) {
+        chunks[i].input = input + i * chunkLen;
+        chunks[i].len = i == threads - 1 ? len - i * chunkLen : chunkLen;
+        if (!InitStreamChecker(&chunks[i].checker, set)) {
+            return false;
+        }
+        chunks[i].checker.summarizing = true;
+        chunks[i].checker.consumed = i * chunkLen;
+    }
+    // the calling thread takes the first chunk itself
+    for (started = 1; started < threads; started++) {
+        if (pthread_create(&chunks[started].thread, NULL, _summarizeChunk, &chunks[started]) != 0) {
+            break;
+        }
+    }
+    StreamChecker total;
+    InitStreamChecker(&total, set);
+    FeedStreamChecker(&total, chunks[0].input, chunks[0].len);
+    for (i = 1; i < threads; i++) {
+        if (i < started) {
+            pthread_join(chunks[i].thread, NULL);
+        } else {
+            _summarizeChunk(&chunks[i]);
+        }
+        // a chunk that can not be merged is scanned again from where the
+        // chunks before it left off, which also finds the exact error offset
+        if (!total.mismatch && !_mergeChunk(&total, &chunks[i].checker)) {
+            FeedStreamChecker(&total, chunks[i].input, chunks[i].len);
+        }
+    }
+    bool balanced = FinishStreamChecker(&total, errorOffset);
+    DestroyStreamChecker(&total);
+    for (i = 0; i < threads; i++) {
+        DestroyStreamChecker(&chunks[i].checker);
+    }
+    return balanced;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "checker.h"
+
+#define STREAM_BLOCK_SIZE 64
+#define STREAM_CHUNK_SIZE (1 << 20)
+// sets with more delimiter bytes than this are classified with the table
+#define STREAM_MAX_SYMBOLS 16
+#define PARALLEL_MAX_THREADS 64
+#define PARALLEL_MIN_CHUNK_SIZE (1 << 20)
+
+// checks the delimiters of a DelimiterSet over input that arrives in
+// chunks. Only openers are kept, as the index of their pair, so memory
+// grows with the nesting depth and not with the input. Offsets are counted
+// from the first byte ever fed. outermostOpen is the offset of the opener
+// that last found the stack empty, which is the first one left unclosed
+// if the input ends with openers still open.
+// A summarizing checker does not fail on closers that find the stack
+// empty, it keeps their pair indexes in unmatched instead, which is what
+// the parallel checker needs from every chunk but the first
+typedef struct {
+    const DelimiterSet* set;
+    uint8_t symbols[STREAM_MAX_SYMBOLS];
+    unsigned int symbolCount;
+    DelimiterStack open;
+    DelimiterStack unmatched;
+    bool summarizing;
+    uint64_t consumed;
+    uint64_t outermostOpen;
+    // the quote of the literal the input is in, 0 outside of literals
+    char quote;
+    uint64_t quoteOffset;
+    // the next byte is escaped
+    bool escaped;
+    bool mismatch;
+    uint64_t mismatchOffset;
+} StreamChecker;
+
+// a checker holds its stacks inline, so it must not be copied once in use
+bool InitStreamChecker(StreamChecker* checker, const DelimiterSet* set);
+void DestroyStreamChecker(StreamChecker* checker);
+// returns false as soon as a closer does not match the last opener, or the
+// stack can not grow, later calls do nothing and keep returning false
+bool FeedStreamChecker(StreamChecker* checker, const char* chunk, size_t len);
+// errorOffset receives the offset of the first unmatched closer, or of the
+// first unclosed opener, or of the quote of a literal left unterminated
+bool FinishStreamChecker(StreamChecker* checker, uint64_t* errorOffset);
+
+typedef struct {
+    const char* input;
+    size_t len;
+    StreamChecker checker;
+    pthread_t thread;
+} ParallelChunk;
+
+bool IsABalancedBuffer(const char* input, size_t len, const DelimiterSet* set, uint64_t* errorOffset);
+bool IsABalancedFile(const char* path, const DelimiterSet* set, uint64_t* errorOffset);
+// same result and errorOffset as IsABalancedBuffer, with the input split
+// across threads; small inputs are checked on the calling thread
+bool IsABalancedBufferParallel(const char* input, size_t len, const DelimiterSet* set, unsigned int threads,
+    uint64_t* errorOffset);
+
+uint64_t _classifyBlock(StreamChecker* checker, const char* block);
+uint64_t _classifyTail(StreamChecker* checker, const char* bytes, size_t len);
+bool _applyMask(StreamChecker* checker, const char* bytes, size_t len, uint64_t structural, uint64_t base);
+void* _summarizeChunk(void* arg);
+bool _mergeChunk(StreamChecker* total, StreamChecker* chunk);
@@ -2,17 +2,332 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
 #include "checker.h"
+#include "streamChecker.h"
+#include "log_capture.h"
 
+// byte at a time reference for the streaming checker
+bool _referenceCheck(const char* input, size_t len, uint64_t* errorOffset) {
+    uint64_t depth = 0, outermostOpen = 0;
+    size_t i;
+    for (i = 0; i < len; i++) {
+        if (input[i] == '(') {
+            if (depth == 0) outermostOpen = i;
+            depth++;
+        }
+        if (input[i] == ')') {
+            if (depth == 0) {
+                *errorOffset = i;
+                return false;
+            }
+            depth--;
+        }
+    }
+    *errorOffset = outermostOpen;
+    return depth == 0;
+}
+
+void _testStreamCheckerOffsets() {
+    uint64_t offset = 0;
+    assert(IsABalancedBuffer("", 0, &DEFAULT_DELIMITERS, &offset) == true);
+    assert(IsABalancedBuffer("(a(b)c)", 7, &DEFAULT_DELIMITERS, &offset) == true);
+    assert(IsABalancedBuffer("(a))b(", 6, &DEFAULT_DELIMITERS, &offset) == false);
+    assert(offset == 3);
+    assert(IsABalancedBuffer("() (x (y)", 9, &DEFAULT_DELIMITERS, &offset) == false);
+    assert(offset == 3);
+    assert(IsABalancedBuffer(")", 1, &DEFAULT_DELIMITERS, &offset) == false);
+    assert(offset == 0);
+    printf("Testing streaming checker error offsets: PASS\n");
+}
+
+void _testStreamCheckerAgainstReference() {
+    size_t len = 5000;
+    char* input = malloc(len);
+    char alphabet[] = "(()) x";
+    uint32_t state = 12345;
+    int round;
+    for (round = 0; round < 200; round++) {
+        size_t i;
+        for (i = 0; i < len; i++) {
+            state = state * 1103515245 + 12345;
+            input[i] = alphabet[(state >> 16) % 6];
+        }
+        // most random strings fail early, so half of the rounds
+        // start from a deeply nested balanced prefix
+        if (round % 2 == 0) {
+            for (i = 0; i < len / 2; i++) {
+                input[i] = '(';
+                input[len - 1 - i] = ')';
+            }
+            input[(state >> 8) % len] = 'x';
+        }
+        uint64_t expectedOffset, offset = 0;
+        bool expected = _referenceCheck(input, len, &expectedOffset);
+
+        // feed the same input in uneven chunks to cross block boundaries
+        StreamChecker checker;
+        InitStreamChecker(&checker, &DEFAULT_DELIMITERS);
+        size_t fed = 0, chunk = 1;
+        while (fed < len) {
+            size_t n = chunk < len - fed ? chunk : len - fed;
+            FeedStreamChecker(&checker, input + fed, n);
+            fed += n;
+            chunk = chunk * 3 % 197 + 1;
+        }
+        assert(FinishStreamChecker(&checker, &offset) == expected);
+        if (!expected) {
+            assert(offset == expectedOffset);
+        }
+        DestroyStreamChecker(&checker);
+        assert(IsABalancedBuffer(input, len, &DEFAULT_DELIMITERS, &offset) == expected);
+    }
+    free(input);
+    printf("Testing streaming checker against the reference: PASS\n");
+}
+
+void _testIsABalancedFile() {
+    char* path = "test_input.txt";
+    FILE* file = fopen(path, "wb");
+    int i;
+    for (i = 0; i < 300000; i++) {
+        fputs("(a(b)c)", file);
+    }
+    fclose(file);
+    uint64_t offset = 0;
+    assert(IsABalancedFile(path, &DEFAULT_DELIMITERS, &offset) == true);
+
+    file = fopen(path, "ab");
+    fputs("))", file);
+    fclose(file);
+    assert(IsABalancedFile(path, &DEFAULT_DELIMITERS, &offset) == false);
+    assert(offset == 300000 * 7);
+    unlink(path);
+    printf("Testing streaming checker over a file: PASS\n");
+}
+
+void _testMixedDelimiters() {
+    size_t offset = 0;
+    assert(IsABalancedStringWith("{a: [1, (2)], b: <c>}", &DEFAULT_DELIMITERS, &offset) == true);
+    assert(IsABalancedStringWith("", &DEFAULT_DELIMITERS, &offset) == true);
+    assert(IsABalancedStringWith("{a: [1, (2]]}", &DEFAULT_DELIMITERS, &offset) == false);
+    assert(offset == 10);
+    assert(IsABalancedStringWith("([)]", &DEFAULT_DELIMITERS, &offset) == false);
+    assert(offset == 2);
+    assert(IsABalancedStringWith("[[[(", &DEFAULT_DELIMITERS, &offset) == false);
+    assert(offset == 4);
+    // the scan stops at the first bad closer, whatever comes after it
+    assert(IsABalancedStringWith("}((((((((", &DEFAULT_DELIMITERS, &offset) == false);
+    assert(offset == 0);
+    printf("Testing mixed delimiters: PASS\n");
+}
+
+void _testQuotesAndEscapes() {
+    size_t offset = 0;
+    assert(IsABalancedStringWith("f(\"(\", ')');", &SOURCE_DELIMITERS, &offset) == true);
+    assert(IsABalancedStringWith("f(\"say \\\"hi)\\\"\")", &SOURCE_DELIMITERS, &offset) == true);
+    assert(IsABalancedStringWith("a \\( b", &SOURCE_DELIMITERS, &offset) == true);
+    assert(IsABalancedStringWith("f(\"unterminated)", &SOURCE_DELIMITERS, &offset) == false);
+    assert(offset == strlen("f(\"unterminated)"));
+    // without quote handling the same input is unbalanced
+    assert(IsABalancedStringWith("f(\"(\")", &DEFAULT_DELIMITERS, &offset) == false);
+    printf("Testing quotes and escapes: PASS\n");
+}
+
+void _testCustomDelimiters() {
+    DelimiterSet set;
+    assert(InitDelimiterSet(&set, "()", NULL, 0) == true);
+    assert(IsABalancedStringWith("[(])", &set, NULL) == true);
+    assert(InitDelimiterSet(&set, "ab", "|", '!') == true);
+    assert(IsABalancedStringWith("a|b|a!bbb", &set, NULL) == true);
+    assert(IsABalancedStringWith("ba", &set, NULL) == false);
+    assert(InitDelimiterSet(&set, "(", NULL, 0) == false);
+    assert(InitDelimiterSet(&set, "||", NULL, 0) == false);
+    assert(InitDelimiterSet(&set, "()", "(", 0) == false);
+    printf("Testing custom delimiters: PASS\n");
+}
+
+// feeds one byte at a time, so every pair, literal and escape crosses a chunk boundary
+bool _feedBytes(const char* input, const DelimiterSet* set, uint64_t* errorOffset) {
+    StreamChecker checker;
+    InitStreamChecker(&checker, set);
+    size_t i, len = strlen(input);
+    for (i = 0; i < len; i++) {
+        FeedStreamChecker(&checker, input + i, 1);
+    }
+    bool balanced = FinishStreamChecker(&checker, errorOffset);
+    DestroyStreamChecker(&checker);
+    return balanced;
+}
+
+void _testStreamCheckerDelimiters() {
+    uint64_t offset = 0;
+    assert(IsABalancedBuffer("{[}]", 4, &DEFAULT_DELIMITERS, &offset) == false);
+    assert(offset == 2);
+    char* json = "{\"key(\": [1, {\"b\": \"]\\\"}\"}], \"c\": \"(\"}";
+    assert(IsABalancedBuffer(json, strlen(json), &SOURCE_DELIMITERS, &offset) == true);
+    assert(_feedBytes(json, &SOURCE_DELIMITERS, &offset) == true);
+    assert(IsABalancedBuffer(json, strlen(json), &DEFAULT_DELIMITERS, &offset) == false);
+    assert(_feedBytes("f(\"unterminated)", &SOURCE_DELIMITERS, &offset) == false);
+    assert(offset == 1);
+    assert(_feedBytes("x \"a\" \"(b", &SOURCE_DELIMITERS, &offset) == false);
+    assert(offset == 6);
+    assert(_feedBytes("a \\( b", &SOURCE_DELIMITERS, &offset) == true);
+
+    // a set with more delimiter bytes than the blocks are compared against
+    DelimiterSet set;
+    assert(InitDelimiterSet(&set, "()[]{}<>abcdefghij", "\"", '\\') == true);
+    assert(IsABalancedBuffer("a(c[e{<>}f]d)bij\"g)\"", 20, &set, &offset) == true);
+    assert(IsABalancedBuffer("a(c[e{<>}f]d)bji", 16, &set, &offset) == false);
+    assert(offset == 14);
 
+    // against the stack checker on random input, in uneven chunks
+    size_t len = 3000;
+    char* input = malloc(len + 1);
+    char alphabet[] = "([{}])\"'\\ x";
+    uint32_t state = 777;
+    int round;
+    for (round = 0; round < 400; round++) {
+        size_t i;
+        for (i = 0; i < len; i++) {
+            state = state * 1103515245 + 12345;
+            input[i] = alphabet[(state >> 16) % 11];
+        }
+        // random quotes and closers end most inputs early, so some rounds
+        // are nested pairs with a literal in the middle instead
+        if (round % 2 == 0) {
+            for (i = 0; i < len / 2 - 8; i++) {
+                input[i] = "([{"[i % 3];
+                input[len - 1 - i] = ")]}"[i % 3];
+            }
+            memcpy(input + i, "\" ) \\\" '", 7);
+            input[(state >> 8) % len] = 'x';
+        }
+        input[len] = '\0';
+        size_t expectedOffset = 0;
+        CheckStatus status = CheckBalance(input, &SOURCE_DELIMITERS, &expectedOffset);
+
+        StreamChecker checker;
+        InitStreamChecker(&checker, &SOURCE_DELIMITERS);
+        size_t fed = 0, chunk = 1;
+        while (fed < len) {
+            size_t n = chunk < len - fed ? chunk : len - fed;
+            FeedStreamChecker(&checker, input + fed, n);
+            fed += n;
+            chunk = chunk * 5 % 211 + 1;
+        }
+        assert(FinishStreamChecker(&checker, &offset) == (status == CHECK_BALANCED));
+        if (status == CHECK_UNMATCHED_CLOSER) {
+            assert(offset == expectedOffset);
+        }
+        DestroyStreamChecker(&checker);
+    }
+    free(input);
+    printf("Testing streaming checker with brackets and literals: PASS\n");
+}
+
+void _testParallelChecker() {
+    size_t len = 9 << 20;
+    char* input = malloc(len);
+    size_t i;
+    // nested groups that often cross the boundaries between chunks
+    for (i = 0; i < len; i++) {
+        size_t position = i % 4096;
+        input[i] = position < 1000 ? '(' : position >= 3096 ? ')' : 'x';
+    }
+    uint64_t expectedOffset = 0, offset = 0;
+    unsigned int threads;
+    for (threads = 1; threads <= 8; threads++) {
+        assert(IsABalancedBufferParallel(input, len, &DEFAULT_DELIMITERS, threads, &offset) == true);
+    }
+
+    size_t positions[] = { 0, 1500, len / 3 + 17, len / 2, len - 1 };
+    char replacements[] = { '(', ')' };
+    int p, r;
+    for (p = 0; p < 5; p++) {
+        for (r = 0; r < 2; r++) {
+            char saved = input[positions[p]];
+            input[positions[p]] = replacements[r];
+            bool expected = IsABalancedBuffer(input, len, &DEFAULT_DELIMITERS, &expectedOffset);
+            for (threads = 2; threads <= 8; threads += 3) {
+                assert(IsABalancedBufferParallel(input, len, &DEFAULT_DELIMITERS, threads, &offset) == expected);
+                if (!expected) {
+                    assert(offset == expectedOffset);
+                }
+            }
+            input[positions[p]] = saved;
+        }
+    }
+
+    // different brackets, and long literals full of closers and escaped
+    // quotes, across the boundaries between chunks
+    len = 4099 * 2300;
+    for (i = 0; i < len; i++) {
+        size_t position = i % 4099;
+        input[i] = position < 1000 ? "([{"[position % 3] : position >= 3099 ? ")]}"[(4098 - position) % 3]
+            : position == 1250 || position == 2950 ? '"' : position < 1250 || position > 2950 ? 'x'
+            : position % 100 == 0 ? '\\' : position % 100 == 1 ? '"' : position % 7 == 0 ? ')' : ']';
+    }
+    bool expected = IsABalancedBuffer(input, len, &SOURCE_DELIMITERS, &expectedOffset);
+    assert(expected == true);
+    for (threads = 2; threads <= 8; threads++) {
+        assert(IsABalancedBufferParallel(input, len, &SOURCE_DELIMITERS, threads, &offset) == true);
+    }
+    size_t literalPositions[] = { 1, 1002, len / 4 + 3, len / 2 + 1, len - 2 };
+    char literalReplacements[] = { '"', ']', 'x' };
+    for (p = 0; p < 5; p++) {
+        for (r = 0; r < 3; r++) {
+            char saved = input[literalPositions[p]];
+            input[literalPositions[p]] = literalReplacements[r];
+            expected = IsABalancedBuffer(input, len, &SOURCE_DELIMITERS, &expectedOffset);
+            for (threads = 2; threads <= 8; threads += 3) {
+                assert(IsABalancedBufferParallel(input, len, &SOURCE_DELIMITERS, threads, &offset) == expected);
+                if (!expected) {
+                    assert(offset == expectedOffset);
+                }
+            }
+            input[literalPositions[p]] = saved;
+        }
+    }
+    free(input);
+    printf("Testing parallel checker: PASS\n");
+}
+
+void _testCheckStatus() {
+    size_t offset = 0;
+    assert(CheckBalance("(a[b]c)", &DEFAULT_DELIMITERS, &offset) == CHECK_BALANCED);
+    assert(CheckBalance("(a]", &DEFAULT_DELIMITERS, &offset) == CHECK_UNMATCHED_CLOSER);
+    assert(offset == 2);
+    assert(CheckBalance("((a)", &DEFAULT_DELIMITERS, &offset) == CHECK_UNCLOSED);
+    assert(CheckBalance("'a", &SOURCE_DELIMITERS, &offset) == CHECK_UNCLOSED);
+    assert(CheckBalance(NULL, &DEFAULT_DELIMITERS, &offset) == CHECK_BAD_ARGUMENT);
+
+    // deep enough to need a stack on the heap
+    size_t len = CHECK_INLINE_DEPTH * 4;
+    char* deep = malloc(len + 1);
+    memset(deep, '(', len / 2);
+    memset(deep + len / 2, ')', len / 2);
+    deep[len] = '\0';
+    assert(CheckBalance(deep, &DEFAULT_DELIMITERS, &offset) == CHECK_BALANCED);
+    deep[len - 1] = '(';
+    assert(CheckBalance(deep, &DEFAULT_DELIMITERS, &offset) == CHECK_UNCLOSED);
+    free(deep);
+
+    SetLogHook(_captureMessage);
+    _logMessage("checked %d strings", 3);
+    assert(strcmp(lastMessage, "checked 3 strings") == 0);
+    SetLogHook(NULL);
+    printf("Testing check statuses and log hook: PASS\n");
+}
 
 int main() {
     char* balancedStrings[5];
-    balancedStrings[1] = "hey";
-    balancedStrings[2] = "(hey there)";
-    balancedStrings[3] = "(hey (there) pal)";
-    balancedStrings[4] = "(((dude (((how are (((you?)))))))))";
-    balancedStrings[5] = "()()()()()()()()()()()";
+    balancedStrings[0] = "hey";
+    balancedStrings[1] = "(hey there)";
+    balancedStrings[2] = "(hey (there) pal)";
+    balancedStrings[3] = "(((dude (((how are (((you?)))))))))";
+    balancedStrings[4] = "()()()()()()()()()()()";
 
     int i;
     for (i = 0; i < 5; i++) {
@@ -31,5 +346,15 @@ int main() {
         bool result = IsABalancedString(unbalancedStrings[i]);
         assert(result == false);
     }
+
+    _testMixedDelimiters();
+    _testCheckStatus();
+    _testQuotesAndEscapes();
+    _testCustomDelimiters();
+    _testStreamCheckerOffsets();
+    _testStreamCheckerAgainstReference();
+    _testIsABalancedFile();
+    _testStreamCheckerDelimiters();
+    _testParallelChecker();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "hash_table.h"
+
+#define KEY_LEN 24
+#define LOOKUP_BATCH 4096
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+uint32_t _nextRandom(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+// the default table (buckets plus nodes) is a few hundred megabytes,
+// pass a bigger entry count if the machine's last level cache is larger
+int main(int argc, char** argv) {
+    unsigned int entries = argc > 1 ? (unsigned int)atoi(argv[1]) : (1u << 22);
+    char* keyData = malloc((size_t)entries * KEY_LEN);
+    char** keys = malloc(entries * sizeof(char*));
+    char** values = malloc(entries * sizeof(char*));
+    ValueView* views = malloc(LOOKUP_BATCH * sizeof(ValueView));
+    unsigned int i;
+    for (i = 0; i < entries; i++) {
+        keys[i] = keyData + (size_t)i * KEY_LEN;
+        snprintf(keys[i], KEY_LEN, "key_%u", i);
+        values[i] = "value";
+    }
+    uint32_t state = 2463534242u;
+    for (i = entries - 1; i > 0; i--) {
+        uint32_t j = _nextRandom(&state) % (i + 1);
+        char* tmp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = tmp;
+    }
+
+    printf("%u entries in random order\n", entries);
+
+    HashTable* single = CreateHashTable(entries);
+    double start = _nowSeconds();
+    for (i = 0; i < entries; i++) {
+        Store(&single, keys[i], values[i]);
+    }
+    double singleStore = _nowSeconds() - start;
+
+    HashTable* batched = CreateHashTable(entries);
+    start = _nowSeconds();
+    for (i = 0; i < entries; i += LOOKUP_BATCH) {
+        unsigned int count = entries - i < LOOKUP_BATCH ? entries - i : LOOKUP_BATCH;
+        StoreMany(&batched, keys + i, values + i, count);
+    }
+    double batchStore = _nowSeconds() - start;
+    printf("Store loop   %6.1f ns/key    StoreMany %6.1f ns/key\n",
+        singleStore * 1e9 / entries, batchStore * 1e9 / entries);
+    DestroyHashTable(&batched);
+
+    // look the keys up in a different random order than they were inserted
+    for (i = entries - 1; i > 0; i--) {
+        uint32_t j = _nextRandom(&state) % (i + 1);
+        char* tmp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = tmp;
+    }
+
+    size_t checksum = 0;
+    start = _nowSeconds();
+    for (i = 0; i < entries; i++) {
+        ValueView view;
+        GetView(single, keys[i], &view);
+        checksum += view.len;
+    }
+    double singleGet = _nowSeconds() - start;
+
+    start = _nowSeconds();
+    for (i = 0; i < entries; i += LOOKUP_BATCH) {
+        unsigned int count = entries - i < LOOKUP_BATCH ? entries - i : LOOKUP_BATCH;
+        GetMany(single, keys + i, count, views);
+        unsigned int j;
+        for (j = 0; j < count; j++) {
+            checksum -= views[j].len;
+        }
+    }
+    double batchGet = _nowSeconds() - start;
+    printf("GetView loop %6.1f ns/key    GetMany   %6.1f ns/key   (checksum %zu)\n",
+        singleGet * 1e9 / entries, batchGet * 1e9 / entries, checksum);
+
+    DestroyHashTable(&single);
+    free(views);
+    free(values);
+    free(keys);
+    free(keyData);
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "hash_table.h"
+#include "concurrent_hash_table.h"
+
+#define ENTRIES (1u << 20)
+#define OPS_PER_THREAD 2000000
+#define KEY_LEN 24
+#define WRITE_PERCENT 10
+
+typedef struct {
+    bool concurrent;
+    HashTable* hashTable;
+    pthread_mutex_t* globalLock;
+    ConcurrentHashTable* concurrentTable;
+    char* keys;
+    unsigned int seed;
+} BenchArgs;
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+unsigned int _nextRandom(unsigned int* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+void* _worker(void* arg) {
+    BenchArgs* args = arg;
+    char buffer[64];
+    unsigned int state = args->seed;
+    int i;
+    for (i = 0; i < OPS_PER_THREAD; i++) {
+        unsigned int r = _nextRandom(&state);
+        char* key = args->keys + (size_t)(r % ENTRIES) * KEY_LEN;
+        bool write = (r >> 24) % 100 < WRITE_PERCENT;
+        if (args->concurrent) {
+            if (write) ConcurrentStore(args->concurrentTable, key, "updated value");
+            else ConcurrentGetInto(args->concurrentTable, key, buffer, sizeof(buffer), NULL);
+            continue;
+        }
+        // this is what wrapping the single threaded table looks like
+        pthread_mutex_lock(args->globalLock);
+        if (write) Store(&args->hashTable, key, "updated value");
+        else GetInto(args->hashTable, key, buffer, sizeof(buffer), NULL);
+        pthread_mutex_unlock(args->globalLock);
+    }
+    return NULL;
+}
+
+double _run(int threads, BenchArgs* base) {
+    pthread_t workers[threads];
+    BenchArgs args[threads];
+    int i;
+    double start = _nowSeconds();
+    for (i = 0; i < threads; i++) {
+        args[i] = *base;
+        args[i].seed = 2463534242u + i * 7919;
+        pthread_create(&workers[i], NULL, _worker, &args[i]);
+    }
+    for (i = 0; i < threads; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    double elapsed = _nowSeconds() - start;
+    return (double)threads * OPS_PER_THREAD / elapsed / 1e6;
+}
+
+int main(int argc, char** argv) {
+    int maxThreads = argc > 1 ? atoi(argv[1]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (maxThreads < 1) maxThreads = 1;
+
+    char* keys = malloc((size_t)ENTRIES * KEY_LEN);
+    HashTable* hashTable = CreateHashTable(ENTRIES);
+    ConcurrentHashTable* concurrentTable = CreateConcurrentHashTable(ENTRIES);
+    pthread_mutex_t globalLock = PTHREAD_MUTEX_INITIALIZER;
+    unsigned int i;
+    for (i = 0; i < ENTRIES; i++) {
+        char* key = keys + (size_t)i * KEY_LEN;
+        snprintf(key, KEY_LEN, "key_%u", i);
+        Store(&hashTable, key, "initial value");
+        ConcurrentStore(concurrentTable, key, "initial value");
+    }
+
+    BenchArgs base = { false, hashTable, &globalLock, concurrentTable, keys, 0 };
+    printf("%d%% writes, %u keys, %d ops per thread, Mops/s\n", WRITE_PERCENT, ENTRIES, OPS_PER_THREAD);
+    printf("%8s %14s %14s\n", "threads", "global mutex", "concurrent");
+    int threads;
+    for (threads = 1; threads <= maxThreads; threads *= 2) {
+        base.concurrent = false;
+        double locked = _run(threads, &base);
+        base.concurrent = true;
+        double concurrent = _run(threads, &base);
+        printf("%8d %14.2f %14.2f\n", threads, locked, concurrent);
+        if (threads < maxThreads && threads * 2 > maxThreads) threads = maxThreads / 2;
+    }
+
+    DestroyHashTable(&hashTable);
+    DestroyConcurrentHashTable(&concurrentTable);
+    free(keys);
+    return 0;
+}
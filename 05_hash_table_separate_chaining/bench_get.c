@@ -0,0 +1,75 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "hash_table.h"
+
+#define ENTRIES (1u << 18)
+#define LOOKUPS (1u << 22)
+#define KEY_LEN 24
+
+// linked with -Wl,--wrap=malloc so every allocation made by the
+// hash table goes through this counter
+void* __real_malloc(size_t size);
+unsigned long mallocCalls = 0;
+
+void* __wrap_malloc(size_t size) {
+    mallocCalls++;
+    return __real_malloc(size);
+}
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void _report(char* name, double elapsed, unsigned long allocations, size_t checksum) {
+    printf("%-10s %7.1f ns/op   %.3f allocations/lookup   (checksum %zu)\n",
+        name, elapsed * 1e9 / LOOKUPS, (double)allocations / LOOKUPS, checksum);
+}
+
+int main(void) {
+    char* keys = malloc((size_t)ENTRIES * KEY_LEN);
+    HashTable* hashTable = CreateHashTable(ENTRIES);
+    unsigned int i;
+    for (i = 0; i < ENTRIES; i++) {
+        char* key = keys + (size_t)i * KEY_LEN;
+        snprintf(key, KEY_LEN, "key_%u", i);
+        Store(&hashTable, key, "a value of some forty bytes, more or less");
+    }
+
+    size_t checksum = 0;
+    unsigned long before = mallocCalls;
+    double start = _nowSeconds();
+    for (i = 0; i < LOOKUPS; i++) {
+        char* value = Get(hashTable, keys + (size_t)(i % ENTRIES) * KEY_LEN);
+        checksum += value[0];
+        free(value);
+    }
+    _report("Get", _nowSeconds() - start, mallocCalls - before, checksum);
+
+    checksum = 0;
+    before = mallocCalls;
+    start = _nowSeconds();
+    for (i = 0; i < LOOKUPS; i++) {
+        ValueView view;
+        GetView(hashTable, keys + (size_t)(i % ENTRIES) * KEY_LEN, &view);
+        checksum += view.data[0];
+    }
+    _report("GetView", _nowSeconds() - start, mallocCalls - before, checksum);
+
+    checksum = 0;
+    before = mallocCalls;
+    start = _nowSeconds();
+    char buffer[64];
+    for (i = 0; i < LOOKUPS; i++) {
+        size_t valueLen;
+        GetInto(hashTable, keys + (size_t)(i % ENTRIES) * KEY_LEN, buffer, sizeof(buffer), &valueLen);
+        checksum += buffer[0];
+    }
+    _report("GetInto", _nowSeconds() - start, mallocCalls - before, checksum);
+
+    DestroyHashTable(&hashTable);
+    free(keys);
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "hash_table.h"
+
+#define THROUGHPUT_BYTES (1u << 28)
+#define HISTOGRAM_BUCKETS (1u << 16)
+#define HISTOGRAM_MAX_CHAIN 8
+
+typedef struct {
+    char* name;
+    HashFunction hashFunction;
+} NamedHash;
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void _benchThroughput(NamedHash* hashes, int hashCount) {
+    size_t keyLens[] = { 8, 16, 32, 64, 256, 4096 };
+    int lenCount = sizeof(keyLens) / sizeof(keyLens[0]);
+    char* buffer = malloc(4096 + 64);
+    int i, f;
+    for (i = 0; i < 4096 + 64; i++) {
+        buffer[i] = 'a' + i % 26;
+    }
+
+    printf("hashing throughput (GB/s)\n%-12s", "key length");
+    for (i = 0; i < lenCount; i++) {
+        printf("%8zu", keyLens[i]);
+    }
+    printf("\n");
+    for (f = 0; f < hashCount; f++) {
+        printf("%-12s", hashes[f].name);
+        for (i = 0; i < lenCount; i++) {
+            size_t iterations = THROUGHPUT_BYTES / keyLens[i];
+            uint64_t sink = 0;
+            size_t j;
+            double start = _nowSeconds();
+            for (j = 0; j < iterations; j++) {
+                sink += hashes[f].hashFunction(buffer + (j & 63), keyLens[i], sink);
+            }
+            double elapsed = _nowSeconds() - start;
+            printf("%8.2f", (double)THROUGHPUT_BYTES / elapsed / 1e9 + (sink == 1 ? 1e-12 : 0));
+        }
+        printf("\n");
+    }
+    free(buffer);
+}
+
+void _printHistogram(NamedHash* hash, char* format) {
+    HashTable* hashTable = CreateHashTableWithHash(HISTOGRAM_BUCKETS, hash->hashFunction, RandomSeed());
+    char key[64];
+    unsigned int i;
+    for (i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        snprintf(key, sizeof(key), format, i);
+        Store(&hashTable, key, "");
+    }
+
+    unsigned int histogram[HISTOGRAM_MAX_CHAIN + 1] = { 0 };
+    unsigned int longest = 0;
+    for (i = 0; i < hashTable->capacity; i++) {
+        unsigned int chainLength = 0;
+        Node* node = hashTable->collection[i];
+        while (node != NULL) {
+            chainLength++;
+            node = node->next;
+        }
+        if (chainLength > longest) longest = chainLength;
+        histogram[chainLength < HISTOGRAM_MAX_CHAIN ? chainLength : HISTOGRAM_MAX_CHAIN]++;
+    }
+    printf("%-12s", hash->name);
+    for (i = 0; i <= HISTOGRAM_MAX_CHAIN; i++) {
+        printf("%8u", histogram[i]);
+    }
+    printf("%9u\n", longest);
+    DestroyHashTable(&hashTable);
+}
+
+int main(void) {
+    NamedHash hashes[] = {
+        { "polynomial", HashPolynomial },
+        { "fnv1a", HashFnv1a },
+        { "wy", HashWy },
+    };
+    int hashCount = sizeof(hashes) / sizeof(hashes[0]);
+    char* formats[] = { "key_%u", "%08u", "/users/%u/profile/settings" };
+    int formatCount = sizeof(formats) / sizeof(formats[0]);
+    int f, i;
+
+    _benchThroughput(hashes, hashCount);
+
+    for (i = 0; i < formatCount; i++) {
+        printf("\nchain lengths for %u keys like \"%s\" in %u buckets\n%-12s", HISTOGRAM_BUCKETS, formats[i], HISTOGRAM_BUCKETS, "function");
+        int j;
+        for (j = 0; j < HISTOGRAM_MAX_CHAIN; j++) {
+            printf("%8d", j);
+        }
+        printf("%7d+%9s\n", HISTOGRAM_MAX_CHAIN, "longest");
+        for (f = 0; f < hashCount; f++) {
+            _printHistogram(&hashes[f], formats[i]);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "hash_table.h"
+
+#define KEY_LEN 24
+#define BENCH_ENTRIES (1u << 20)
+#define LIST_ROUNDS 1000000
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// build once as is and once with -DLIBRARY_LOGGING, the
+// difference is what the messages cost on these paths
+int main(void) {
+#ifdef LIBRARY_LOGGING
+    char* mode = "logging on ";
+#else
+    char* mode = "logging off";
+#endif
+    char* keys = malloc((size_t)BENCH_ENTRIES * KEY_LEN);
+    unsigned int i;
+    for (i = 0; i < BENCH_ENTRIES; i++) {
+        snprintf(keys + (size_t)i * KEY_LEN, KEY_LEN, "key_%u", i);
+    }
+
+    double start = _nowSeconds();
+    HashTable* hashTable = CreateHashTable(16);
+    for (i = 0; i < BENCH_ENTRIES; i++) {
+        Store(&hashTable, keys + (size_t)i * KEY_LEN, "value");
+    }
+    double storeTime = _nowSeconds() - start;
+
+    // lists that are cleared right away, and removals of missing keys,
+    // both used to print a line every time
+    start = _nowSeconds();
+    unsigned int removed = 0;
+    for (i = 0; i < LIST_ROUNDS; i++) {
+        Node* head = CreateNode("key", "value");
+        removed += !RemoveNode(&head, "missing");
+        removed += ClearList(&head);
+    }
+    double listTime = _nowSeconds() - start;
+
+    printf("%s  Store %6.1f ns/op   list churn %6.1f ns/op   (%u)\n", mode,
+        storeTime * 1e9 / BENCH_ENTRIES, listTime * 1e9 / LIST_ROUNDS, removed);
+    DestroyHashTable(&hashTable);
+    free(keys);
+    return 0;
+}
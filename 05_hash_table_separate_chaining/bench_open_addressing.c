@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "hash_table.h"
+#include "open_addressing.h"
+
+#define BENCH_CAPACITY (1u << 20)
+#define KEY_LEN 24
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+char* _generateKeys(unsigned int count, char* prefix) {
+    char* keys = malloc((size_t)count * KEY_LEN);
+    unsigned int i;
+    for (i = 0; i < count; i++) {
+        snprintf(keys + (size_t)i * KEY_LEN, KEY_LEN, "%s_%u", prefix, i);
+    }
+    return keys;
+}
+
+void _benchChained(char* keys, char* missingKeys, unsigned int count) {
+    HashTable* hashTable = CreateHashTable(BENCH_CAPACITY);
+    unsigned int i;
+
+    double start = _nowSeconds();
+    for (i = 0; i < count; i++) {
+        Store(&hashTable, keys + (size_t)i * KEY_LEN, "value");
+    }
+    double storeTime = _nowSeconds() - start;
+
+    start = _nowSeconds();
+    for (i = 0; i < count; i++) {
+        free(Get(hashTable, keys + (size_t)i * KEY_LEN));
+    }
+    double hitTime = _nowSeconds() - start;
+
+    start = _nowSeconds();
+    for (i = 0; i < count; i++) {
+        free(Get(hashTable, missingKeys + (size_t)i * KEY_LEN));
+    }
+    double missTime = _nowSeconds() - start;
+
+    printf("  chained   store %7.1f ns/op   get hit %7.1f ns/op   get miss %7.1f ns/op\n",
+        storeTime * 1e9 / count, hitTime * 1e9 / count, missTime * 1e9 / count);
+    DestroyHashTable(&hashTable);
+}
+
+void _benchOpen(char* keys, char* missingKeys, unsigned int count) {
+    OpenHashTable* table = CreateOpenHashTable(BENCH_CAPACITY);
+    unsigned int i;
+
+    double start = _nowSeconds();
+    for (i = 0; i < count; i++) {
+        OpenStore(table, keys + (size_t)i * KEY_LEN, "value");
+    }
+    double storeTime = _nowSeconds() - start;
+
+    start = _nowSeconds();
+    for (i = 0; i < count; i++) {
+        free(OpenGet(table, keys + (size_t)i * KEY_LEN));
+    }
+    double hitTime = _nowSeconds() - start;
+
+    start = _nowSeconds();
+    for (i = 0; i < count; i++) {
+        free(OpenGet(table, missingKeys + (size_t)i * KEY_LEN));
+    }
+    double missTime = _nowSeconds() - start;
+
+    printf("  open      store %7.1f ns/op   get hit %7.1f ns/op   get miss %7.1f ns/op\n",
+        storeTime * 1e9 / count, hitTime * 1e9 / count, missTime * 1e9 / count);
+    DestroyOpenHashTable(&table);
+}
+
+int main(void) {
+    double loadFactors[] = { 0.25, 0.5, 0.75, 0.85 };
+    int i, len;
+    len = sizeof(loadFactors) / sizeof(loadFactors[0]);
+
+    unsigned int maxCount = BENCH_CAPACITY;
+    char* keys = _generateKeys(maxCount, "key");
+    char* missingKeys = _generateKeys(maxCount, "missing");
+
+    printf("%u buckets/slots, %d byte keys\n", BENCH_CAPACITY, KEY_LEN);
+    for (i = 0; i < len; i++) {
+        unsigned int count = (unsigned int)(BENCH_CAPACITY * loadFactors[i]);
+        printf("load factor %.2f (%u entries)\n", loadFactors[i], count);
+        _benchChained(keys, missingKeys, count);
+        _benchOpen(keys, missingKeys, count);
+    }
+    free(keys);
+    free(missingKeys);
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "hash_table.h"
+
+#define ENTRIES 1000000
+#define CHURN_OPS 2000000
+#define KEY_LEN 24
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void _bench(char* keys, Pool* pool) {
+    double start = _nowSeconds();
+    HashTable* hashTable = pool ? CreateHashTableWithPool(ENTRIES, pool) : CreateHashTable(ENTRIES);
+    unsigned int i;
+    for (i = 0; i < ENTRIES; i++) {
+        Store(&hashTable, keys + (size_t)i * KEY_LEN, "value");
+    }
+    double build = _nowSeconds() - start;
+
+    // remove one key and store it back, so every operation frees and allocates a node
+    start = _nowSeconds();
+    for (i = 0; i < CHURN_OPS; i++) {
+        char* key = keys + (size_t)((i * 7919u) % ENTRIES) * KEY_LEN;
+        Remove(hashTable, key);
+        Store(&hashTable, key, "value");
+    }
+    double churn = _nowSeconds() - start;
+
+    start = _nowSeconds();
+    DestroyHashTable(&hashTable);
+    if (pool) {
+        PoolReset(pool);
+    }
+    double teardown = _nowSeconds() - start;
+
+    printf("%-8s build %6.1f ns/entry   churn %6.1f ns/op   teardown %9.0f us\n",
+        pool ? "pool" : "malloc", build * 1e9 / ENTRIES, churn * 1e9 / CHURN_OPS, teardown * 1e6);
+}
+
+int main(void) {
+    char* keys = malloc((size_t)ENTRIES * KEY_LEN);
+    unsigned int i;
+    for (i = 0; i < ENTRIES; i++) {
+        snprintf(keys + (size_t)i * KEY_LEN, KEY_LEN, "key_%u", i);
+    }
+    Pool* pool = CreatePool(sizeof(Node) + 32, 4096);
+    printf("%d entries, nodes of up to %zu bytes\n", ENTRIES, pool->objectSize);
+    _bench(keys, NULL);
+    _bench(keys, pool);
+    DestroyPool(&pool);
+    free(keys);
+    return 0;
+}
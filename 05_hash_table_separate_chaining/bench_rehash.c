@@ -0,0 +1,59 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "hash_table.h"
+
+#define ENTRIES 2000000
+#define KEY_LEN 24
+
+double _nowNanoseconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int _compareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// stopTheWorld finishes every migration inside the Store that started it,
+// which is what the table did before rehashing became incremental
+void _benchStores(char* keys, double* latencies, bool stopTheWorld) {
+    HashTable* hashTable = CreateHashTable(INITIAL_CAPACITY);
+    unsigned int i;
+    double total = 0;
+    for (i = 0; i < ENTRIES; i++) {
+        double start = _nowNanoseconds();
+        Store(&hashTable, keys + (size_t)i * KEY_LEN, "value");
+        if (stopTheWorld) {
+            _rehashStep(hashTable, hashTable->oldCapacity);
+        }
+        latencies[i] = _nowNanoseconds() - start;
+        total += latencies[i];
+    }
+    qsort(latencies, ENTRIES, sizeof(double), _compareDoubles);
+    printf("%-15s mean %6.0f ns   p50 %6.0f ns   p99 %6.0f ns   p99.99 %9.0f ns   max %11.0f ns\n",
+        stopTheWorld ? "stop the world" : "incremental",
+        total / ENTRIES,
+        latencies[ENTRIES / 2],
+        latencies[(size_t)(ENTRIES * 0.99)],
+        latencies[(size_t)(ENTRIES * 0.9999)],
+        latencies[ENTRIES - 1]);
+    DestroyHashTable(&hashTable);
+}
+
+int main(void) {
+    char* keys = malloc((size_t)ENTRIES * KEY_LEN);
+    double* latencies = malloc(ENTRIES * sizeof(double));
+    unsigned int i;
+    for (i = 0; i < ENTRIES; i++) {
+        snprintf(keys + (size_t)i * KEY_LEN, KEY_LEN, "key_%u", i);
+    }
+    _benchStores(keys, latencies, true);
+    _benchStores(keys, latencies, false);
+    free(keys);
+    free(latencies);
+    return 0;
+}
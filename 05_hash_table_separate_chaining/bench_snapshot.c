@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "snapshot.h"
+
+#define KEY_LEN 24
+#define BENCH_ENTRIES (1u << 21)
+#define SNAPSHOT_PATH "bench_snapshot.bin"
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(void) {
+    char* keys = malloc((size_t)BENCH_ENTRIES * KEY_LEN);
+    unsigned int i;
+    for (i = 0; i < BENCH_ENTRIES; i++) {
+        snprintf(keys + (size_t)i * KEY_LEN, KEY_LEN, "key_%u", i);
+    }
+    printf("%u entries\n", BENCH_ENTRIES);
+
+    double start = _nowSeconds();
+    HashTable* hashTable = CreateHashTable(16);
+    for (i = 0; i < BENCH_ENTRIES; i++) {
+        Store(&hashTable, keys + (size_t)i * KEY_LEN, "some value of moderate length");
+    }
+    printf("  build table      %8.1f ms\n", (_nowSeconds() - start) * 1e3);
+
+    start = _nowSeconds();
+    SaveSnapshot(hashTable, SNAPSHOT_PATH);
+    printf("  save snapshot    %8.1f ms\n", (_nowSeconds() - start) * 1e3);
+
+    start = _nowSeconds();
+    Snapshot* snapshot = OpenSnapshot(SNAPSHOT_PATH);
+    printf("  open snapshot    %8.3f ms\n", (_nowSeconds() - start) * 1e3);
+
+    size_t checksum = 0;
+    ValueView view;
+    start = _nowSeconds();
+    for (i = 0; i < BENCH_ENTRIES; i++) {
+        GetView(hashTable, keys + (size_t)i * KEY_LEN, &view);
+        checksum += view.len;
+    }
+    double tableTime = _nowSeconds() - start;
+
+    printf("  GetView          %8.1f ns/op\n", tableTime * 1e9 / BENCH_ENTRIES);
+
+    // the first pass also pays for mapping every page of the file
+    int pass;
+    for (pass = 0; pass < 2; pass++) {
+        start = _nowSeconds();
+        for (i = 0; i < BENCH_ENTRIES; i++) {
+            SnapshotGetView(snapshot, keys + (size_t)i * KEY_LEN, &view);
+            checksum += view.len;
+        }
+        double snapshotTime = _nowSeconds() - start;
+        printf("  SnapshotGetView  %8.1f ns/op   (%s pages)\n",
+            snapshotTime * 1e9 / BENCH_ENTRIES, pass == 0 ? "cold" : "warm");
+    }
+    printf("  checksum %zu\n", checksum);
+
+    CloseSnapshot(&snapshot);
+    DestroyHashTable(&hashTable);
+    unlink(SNAPSHOT_PATH);
+    free(keys);
+    return 0;
+}
@@ -0,0 +1,254 @@
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "concurrent_hash_table.h"
+
+ConcurrentNode* _concurrentCreateNode(char* key, uint32_t keyLen, char* value, uint32_t valueLen, uint64_t hash) {
+    ConcurrentNode* node = malloc(sizeof(ConcurrentNode) + keyLen + valueLen + 2);
+    if (node == NULL) {
+        return NULL;
+    }
+    atomic_init(&node->next, NULL);
+    node->hash = hash;
+    node->keyLen = keyLen;
+    node->valueLen = valueLen;
+    memcpy(node->data, key, keyLen + 1);
+    memcpy(node->data + keyLen + 1, value, valueLen + 1);
+    return node;
+}
+
+ConcurrentBuckets* _concurrentCreateBuckets(unsigned int capacity) {
+    ConcurrentBuckets* buckets = malloc(sizeof(ConcurrentBuckets) + capacity * sizeof(ConcurrentNode*));
+    if (buckets == NULL) {
+        return NULL;
+    }
+    buckets->capacity = capacity;
+    unsigned int i;
+    for (i = 0; i < capacity; i++) {
+        atomic_init(&buckets->heads[i], NULL);
+    }
+    return buckets;
+}
+
+void _concurrentFreeBuckets(ConcurrentBuckets* buckets) {
+    unsigned int i;
+    for (i = 0; i < buckets->capacity; i++) {
+        ConcurrentNode* node = atomic_load_explicit(&buckets->heads[i], memory_order_relaxed);
+        while (node != NULL) {
+            ConcurrentNode* next = atomic_load_explicit(&node->next, memory_order_relaxed);
+            free(node);
+            node = next;
+        }
+    }
+    free(buckets);
+}
+
+void _concurrentReleaseNode(RetiredItem* item) {
+    free(RETIRED_ENTRY(item, ConcurrentNode, retired));
+}
+
+void _concurrentReleaseBuckets(RetiredItem* item) {
+    _concurrentFreeBuckets(RETIRED_ENTRY(item, ConcurrentBuckets, retired));
+}
+
+ConcurrentHashTable* CreateConcurrentHashTable(unsigned int capacity) {
+    // stripes are picked from the low bits of the hash, so every bucket
+    // must map to exactly one stripe
+    unsigned int rounded = CONCURRENT_LOCK_STRIPES;
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+    ConcurrentHashTable* table = aligned_alloc(CACHE_LINE_SIZE, sizeof(ConcurrentHashTable));
+    if (table == NULL) {
+        LOG("error: could not initialize concurrent hash table");
+        return NULL;
+    }
+    ConcurrentBuckets* buckets = _concurrentCreateBuckets(rounded);
+    if (buckets == NULL || !InitEpochDomain(&table->epoch)) {
+        LOG("error: could not initialize concurrent hash table");
+        free(buckets);
+        free(table);
+        return NULL;
+    }
+    atomic_init(&table->buckets, buckets);
+    atomic_init(&table->storedElements, 0);
+    table->hashFunction = HashWy;
+    table->seed = RandomSeed();
+    int i;
+    for (i = 0; i < CONCURRENT_LOCK_STRIPES; i++) {
+        pthread_mutex_init(&table->stripes[i].lock, NULL);
+    }
+    return table;
+}
+
+void DestroyConcurrentHashTable(ConcurrentHashTable** tableP) {
+    if (tableP == NULL || *tableP == NULL) {
+        return;
+    }
+    ConcurrentHashTable* table = *tableP;
+    _concurrentFreeBuckets(atomic_load(&table->buckets));
+    DestroyEpochDomain(&table->epoch);
+    int i;
+    for (i = 0; i < CONCURRENT_LOCK_STRIPES; i++) {
+        pthread_mutex_destroy(&table->stripes[i].lock);
+    }
+    free(table);
+    *tableP = NULL;
+}
+
+bool _concurrentResize(ConcurrentHashTable* table, ConcurrentBuckets* expected) {
+    int i;
+    for (i = 0; i < CONCURRENT_LOCK_STRIPES; i++) {
+        pthread_mutex_lock(&table->stripes[i].lock);
+    }
+    ConcurrentBuckets* oldBuckets = atomic_load_explicit(&table->buckets, memory_order_relaxed);
+    ConcurrentBuckets* newBuckets = NULL;
+    if (oldBuckets == expected) {
+        newBuckets = _concurrentCreateBuckets(oldBuckets->capacity * 2);
+    }
+    bool success = newBuckets != NULL;
+    unsigned int j;
+    for (j = 0; success && j < oldBuckets->capacity; j++) {
+        ConcurrentNode* node = atomic_load_explicit(&oldBuckets->heads[j], memory_order_relaxed);
+        while (node != NULL) {
+            // readers may still be walking the old chains, so nodes are
+            // copied instead of relinked
+            char* key = node->data;
+            ConcurrentNode* copy = _concurrentCreateNode(key, node->keyLen, key + node->keyLen + 1, node->valueLen, node->hash);
+            if (copy == NULL) {
+                success = false;
+                break;
+            }
+            unsigned int position = copy->hash & (newBuckets->capacity - 1);
+            atomic_init(&copy->next, atomic_load_explicit(&newBuckets->heads[position], memory_order_relaxed));
+            atomic_init(&newBuckets->heads[position], copy);
+            node = atomic_load_explicit(&node->next, memory_order_relaxed);
+        }
+    }
+    if (success) {
+        atomic_store_explicit(&table->buckets, newBuckets, memory_order_release);
+    }
+    for (i = CONCURRENT_LOCK_STRIPES - 1; i >= 0; i--) {
+        pthread_mutex_unlock(&table->stripes[i].lock);
+    }
+    if (!success) {
+        if (newBuckets != NULL) {
+            _concurrentFreeBuckets(newBuckets);
+        }
+        return false;
+    }
+    EpochRetire(&table->epoch, &oldBuckets->retired, _concurrentReleaseBuckets);
+    return true;
+}
+
+// only called with the key's stripe locked, so no other writer can touch the chain
+_Atomic(ConcurrentNode*)* _concurrentFindLink(ConcurrentBuckets* buckets, char* key, uint32_t keyLen, uint64_t hash) {
+    _Atomic(ConcurrentNode*)* link = &buckets->heads[hash & (buckets->capacity - 1)];
+    ConcurrentNode* node = atomic_load_explicit(link, memory_order_relaxed);
+    while (node != NULL) {
+        if (node->hash == hash && node->keyLen == keyLen && memcmp(node->data, key, keyLen) == 0) {
+            break;
+        }
+        link = &node->next;
+        node = atomic_load_explicit(link, memory_order_relaxed);
+    }
+    return link;
+}
+
+bool ConcurrentStore(ConcurrentHashTable* table, char* key, char* value) {
+    if (table == NULL || key == NULL || value == NULL) {
+        LOG("error: bad values provided");
+        return false;
+    }
+    uint32_t keyLen = strlen(key);
+    uint64_t hash = table->hashFunction(key, keyLen, table->seed);
+    ConcurrentNode* newNode = _concurrentCreateNode(key, keyLen, value, strlen(value), hash);
+    if (newNode == NULL) {
+        LOG("error: could not allocate memory for node");
+        return false;
+    }
+
+    pthread_mutex_t* lock = &table->stripes[hash & (CONCURRENT_LOCK_STRIPES - 1)].lock;
+    pthread_mutex_lock(lock);
+    ConcurrentBuckets* buckets = atomic_load_explicit(&table->buckets, memory_order_acquire);
+    _Atomic(ConcurrentNode*)* link = _concurrentFindLink(buckets, key, keyLen, hash);
+    ConcurrentNode* node = atomic_load_explicit(link, memory_order_relaxed);
+
+    if (node != NULL) {
+        atomic_init(&newNode->next, atomic_load_explicit(&node->next, memory_order_relaxed));
+        atomic_store_explicit(link, newNode, memory_order_release);
+        pthread_mutex_unlock(lock);
+        EpochRetire(&table->epoch, &node->retired, _concurrentReleaseNode);
+        return true;
+    }
+
+    link = &buckets->heads[hash & (buckets->capacity - 1)];
+    atomic_init(&newNode->next, atomic_load_explicit(link, memory_order_relaxed));
+    atomic_store_explicit(link, newNode, memory_order_release);
+    unsigned int capacity = buckets->capacity;
+    pthread_mutex_unlock(lock);
+
+    // buckets is only compared from here on, it may already be retired
+    unsigned int stored = atomic_fetch_add(&table->storedElements, 1) + 1;
+    if (stored > capacity * CONCURRENT_MAX_LOAD_FACTOR) {
+        _concurrentResize(table, buckets);
+    }
+    return true;
+}
+
+bool ConcurrentGetInto(ConcurrentHashTable* table, char* key, char* buffer, size_t bufferLen, size_t* valueLen) {
+    if (table == NULL || key == NULL) {
+        LOG("error: bad values provided");
+        return false;
+    }
+    uint32_t keyLen = strlen(key);
+    uint64_t hash = table->hashFunction(key, keyLen, table->seed);
+
+    int slot = EpochEnter(&table->epoch);
+    ConcurrentBuckets* buckets = atomic_load_explicit(&table->buckets, memory_order_acquire);
+    ConcurrentNode* node = atomic_load_explicit(&buckets->heads[hash & (buckets->capacity - 1)], memory_order_acquire);
+    while (node != NULL) {
+        if (node->hash == hash && node->keyLen == keyLen && memcmp(node->data, key, keyLen) == 0) {
+            break;
+        }
+        node = atomic_load_explicit(&node->next, memory_order_acquire);
+    }
+    if (node == NULL) {
+        EpochExit(&table->epoch, slot);
+        return false;
+    }
+    if (valueLen != NULL) {
+        *valueLen = node->valueLen;
+    }
+    if (buffer != NULL && bufferLen > 0) {
+        size_t toCopy = node->valueLen < bufferLen - 1 ? node->valueLen : bufferLen - 1;
+        memcpy(buffer, node->data + keyLen + 1, toCopy);
+        buffer[toCopy] = '\0';
+    }
+    EpochExit(&table->epoch, slot);
+    return true;
+}
+
+bool ConcurrentRemove(ConcurrentHashTable* table, char* key) {
+    if (table == NULL || key == NULL) {
+        LOG("error: bad values provided");
+        return false;
+    }
+    uint32_t keyLen = strlen(key);
+    uint64_t hash = table->hashFunction(key, keyLen, table->seed);
+
+    pthread_mutex_t* lock = &table->stripes[hash & (CONCURRENT_LOCK_STRIPES - 1)].lock;
+    pthread_mutex_lock(lock);
+    ConcurrentBuckets* buckets = atomic_load_explicit(&table->buckets, memory_order_acquire);
+    _Atomic(ConcurrentNode*)* link = _concurrentFindLink(buckets, key, keyLen, hash);
+    ConcurrentNode* node = atomic_load_explicit(link, memory_order_relaxed);
+    if (node == NULL) {
+        pthread_mutex_unlock(lock);
+        return false;
+    }
+    atomic_store_explicit(link, atomic_load_explicit(&node->next, memory_order_relaxed), memory_order_release);
+    atomic_fetch_sub(&table->storedElements, 1);
+    pthread_mutex_unlock(lock);
+    EpochRetire(&table->epoch, &node->retired, _concurrentReleaseNode);
+    return true;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "hash_functions.h"
+#include "log.h"
+#include "epoch.h"
+
+#define CONCURRENT_LOCK_STRIPES 64
+#define CONCURRENT_MAX_LOAD_FACTOR 1.5
+
+// nodes are never modified once they are reachable by readers,
+// an update links a new node in place of the old one.
+// retired links the node into its writer's retire list once it is unlinked
+typedef struct ConcurrentNode_T {
+    _Atomic(struct ConcurrentNode_T*) next;
+    RetiredItem retired;
+    uint64_t hash;
+    uint32_t keyLen;
+    uint32_t valueLen;
+    char data[];
+} ConcurrentNode;
+
+typedef struct {
+    RetiredItem retired;
+    unsigned int capacity;
+    _Atomic(ConcurrentNode*) heads[];
+} ConcurrentBuckets;
+
+typedef struct {
+    _Alignas(CACHE_LINE_SIZE) pthread_mutex_t lock;
+} LockStripe;
+
+// writers take the stripe that covers the key's bucket, readers never
+// lock and rely on the epoch domain to keep what they read alive
+typedef struct {
+    _Atomic(ConcurrentBuckets*) buckets;
+    _Atomic unsigned int storedElements;
+    HashFunction hashFunction;
+    uint64_t seed;
+    LockStripe stripes[CONCURRENT_LOCK_STRIPES];
+    EpochDomain epoch;
+} ConcurrentHashTable;
+
+ConcurrentHashTable* CreateConcurrentHashTable(unsigned int capacity);
+void DestroyConcurrentHashTable(ConcurrentHashTable** tableP);
+bool ConcurrentStore(ConcurrentHashTable* table, char* key, char* value);
+// same contract as GetInto: copies at most bufferLen - 1 bytes plus a terminator
+bool ConcurrentGetInto(ConcurrentHashTable* table, char* key, char* buffer, size_t bufferLen, size_t* valueLen);
+bool ConcurrentRemove(ConcurrentHashTable* table, char* key);
+
+ConcurrentNode* _concurrentCreateNode(char* key, uint32_t keyLen, char* value, uint32_t valueLen, uint64_t hash);
+ConcurrentBuckets* _concurrentCreateBuckets(unsigned int capacity);
+void _concurrentFreeBuckets(ConcurrentBuckets* buckets);
+void _concurrentReleaseNode(RetiredItem* item);
+void _concurrentReleaseBuckets(RetiredItem* item);
+_Atomic(ConcurrentNode*)* _concurrentFindLink(ConcurrentBuckets* buckets, char* key, uint32_t keyLen, uint64_t hash);
+bool _concurrentResize(ConcurrentHashTable* table, ConcurrentBuckets* expected);
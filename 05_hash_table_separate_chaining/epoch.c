@@ -0,0 +1,139 @@
+#include <stdatomic.h>
+#include <pthread.h>
+#include "epoch.h"
+
+// thread ids index the slots of every domain, they are handed back
+// when a thread exits so long running programs can keep spawning threads
+static _Atomic bool idTaken[EPOCH_MAX_THREADS];
+static _Atomic int highestId = -1;
+static pthread_key_t idKey;
+static pthread_once_t idKeyOnce = PTHREAD_ONCE_INIT;
+static _Thread_local int threadId = -1;
+
+void _epochReleaseThreadId(void* value) {
+    int id = (int)(intptr_t)value - 1;
+    atomic_store(&idTaken[id], false);
+}
+
+void _epochCreateIdKey() {
+    pthread_key_create(&idKey, _epochReleaseThreadId);
+}
+
+int _epochThreadId() {
+    if (threadId >= 0) {
+        return threadId;
+    }
+    pthread_once(&idKeyOnce, _epochCreateIdKey);
+    int id;
+    for (id = 0; id < EPOCH_MAX_THREADS; id++) {
+        bool expected = false;
+        if (atomic_compare_exchange_strong(&idTaken[id], &expected, true)) {
+            break;
+        }
+    }
+    if (id == EPOCH_MAX_THREADS) {
+        return -1;
+    }
+    int highest = atomic_load(&highestId);
+    while (highest < id && !atomic_compare_exchange_weak(&highestId, &highest, id));
+    pthread_setspecific(idKey, (void*)(intptr_t)(id + 1));
+    threadId = id;
+    return id;
+}
+
+bool InitEpochDomain(EpochDomain* domain) {
+    atomic_init(&domain->globalEpoch, 0);
+    int i, j;
+    for (i = 0; i < EPOCH_MAX_THREADS; i++) {
+        atomic_init(&domain->slots[i].state, 0);
+        for (j = 0; j < 3; j++) {
+            domain->slots[i].retired[j] = NULL;
+            domain->slots[i].retiredEpoch[j] = 0;
+        }
+        domain->slots[i].retiresSinceAdvance = 0;
+    }
+    return true;
+}
+
+void _epochReleaseList(RetiredItem* item) {
+    while (item != NULL) {
+        RetiredItem* next = item->next;
+        item->release(item);
+        item = next;
+    }
+}
+
+void DestroyEpochDomain(EpochDomain* domain) {
+    int i, j;
+    for (i = 0; i < EPOCH_MAX_THREADS; i++) {
+        for (j = 0; j < 3; j++) {
+            _epochReleaseList(domain->slots[i].retired[j]);
+            domain->slots[i].retired[j] = NULL;
+        }
+    }
+}
+
+int EpochEnter(EpochDomain* domain) {
+    int slot = _epochThreadId();
+    if (slot < 0) {
+        LOG("error: more than %d threads are using epochs", EPOCH_MAX_THREADS);
+        abort();
+    }
+    uint64_t epoch = atomic_load(&domain->globalEpoch);
+    atomic_store(&domain->slots[slot].state, (epoch << 1) | 1);
+    atomic_thread_fence(memory_order_seq_cst);
+    return slot;
+}
+
+void EpochExit(EpochDomain* domain, int slot) {
+    atomic_store_explicit(&domain->slots[slot].state, 0, memory_order_release);
+}
+
+// any thread may call it, the compare and swap makes sure the epoch
+// moves forward only once for everyone who saw it
+bool _epochTryAdvance(EpochDomain* domain) {
+    uint64_t epoch = atomic_load(&domain->globalEpoch);
+    int highest = atomic_load(&highestId);
+    int i;
+    for (i = 0; i <= highest; i++) {
+        uint64_t state = atomic_load(&domain->slots[i].state);
+        if ((state & 1) && (state >> 1) != epoch) {
+            return false;
+        }
+    }
+    return atomic_compare_exchange_strong(&domain->globalEpoch, &epoch, epoch + 1);
+}
+
+// whatever was retired two epochs ago or earlier is unreachable: every
+// reader active back then has left, since the epoch moved on twice
+void _epochReleaseOld(EpochSlot* slot, uint64_t epoch) {
+    int i;
+    for (i = 0; i < 3; i++) {
+        if (slot->retired[i] != NULL && slot->retiredEpoch[i] + 2 <= epoch) {
+            _epochReleaseList(slot->retired[i]);
+            slot->retired[i] = NULL;
+        }
+    }
+}
+
+void EpochRetire(EpochDomain* domain, RetiredItem* item, void (*release)(RetiredItem*)) {
+    int id = _epochThreadId();
+    if (id < 0) {
+        LOG("error: more than %d threads are using epochs", EPOCH_MAX_THREADS);
+        abort();
+    }
+    EpochSlot* slot = &domain->slots[id];
+    if (++slot->retiresSinceAdvance >= EPOCH_ADVANCE_EVERY) {
+        slot->retiresSinceAdvance = 0;
+        _epochTryAdvance(domain);
+    }
+    uint64_t epoch = atomic_load(&domain->globalEpoch);
+    _epochReleaseOld(slot, epoch);
+    // the list for this epoch was either released above or already holds
+    // items of this very epoch
+    int list = epoch % 3;
+    item->release = release;
+    item->next = slot->retired[list];
+    slot->retired[list] = item;
+    slot->retiredEpoch[list] = epoch;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "log.h"
+
+#define EPOCH_MAX_THREADS 128
+#define CACHE_LINE_SIZE 64
+// a thread tries to move the global epoch forward once every this many retires
+#define EPOCH_ADVANCE_EVERY 32
+
+// embedded in whatever is retired, so retiring never allocates.
+// RETIRED_ENTRY goes back from the link to the struct that holds it
+typedef struct RetiredItem_T {
+    struct RetiredItem_T* next;
+    void (*release)(struct RetiredItem_T*);
+} RetiredItem;
+
+#define RETIRED_ENTRY(item, type, member) ((type*)((char*)(item) - offsetof(type, member)))
+
+// state is 0 while the thread is outside a critical section,
+// otherwise it holds the epoch the thread observed, shifted left and tagged with 1.
+// The retired lists are private to the thread holding the slot, one per
+// epoch modulo 3, with the epoch their items were retired in
+typedef struct {
+    _Alignas(CACHE_LINE_SIZE) _Atomic uint64_t state;
+    _Alignas(CACHE_LINE_SIZE) RetiredItem* retired[3];
+    uint64_t retiredEpoch[3];
+    unsigned int retiresSinceAdvance;
+} EpochSlot;
+
+// epoch based reclamation: memory unlinked from a shared structure is
+// retired instead of freed, and only released once every reader that
+// could still be looking at it has left its critical section.
+// Every thread retires into its own slot, so writers share no lock
+typedef struct {
+    _Atomic uint64_t globalEpoch;
+    EpochSlot slots[EPOCH_MAX_THREADS];
+} EpochDomain;
+
+bool InitEpochDomain(EpochDomain* domain);
+// releases everything still retired, no thread may be using the domain
+void DestroyEpochDomain(EpochDomain* domain);
+int EpochEnter(EpochDomain* domain);
+void EpochExit(EpochDomain* domain, int slot);
+// release is called with item once no reader can reach it anymore
+void EpochRetire(EpochDomain* domain, RetiredItem* item, void (*release)(RetiredItem*));
+
+int _epochThreadId();
+bool _epochTryAdvance(EpochDomain* domain);
+void _epochReleaseList(RetiredItem* item);
+void _epochReleaseOld(EpochSlot* slot, uint64_t epoch);
@@ -0,0 +1,111 @@
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#ifdef __linux__
+#include <sys/random.h>
+#endif
+#include "hash_functions.h"
+
+uint64_t HashPolynomial(const char* key, size_t len, uint64_t seed) {
+    uint64_t hash = seed;
+    size_t i;
+    for (i = 0; i < len; i++) {
+        hash = hash * 31 + (uint8_t)key[i];
+    }
+    return hash;
+}
+
+uint64_t HashFnv1a(const char* key, size_t len, uint64_t seed) {
+    uint64_t hash = 14695981039346656037ull ^ seed;
+    size_t i;
+    for (i = 0; i < len; i++) {
+        hash ^= (uint8_t)key[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+#define WY_P0 0x2d358dccaa6c78a5ull
+#define WY_P1 0x8bb84b93962eacc9ull
+#define WY_P2 0x4b33a62ed433d4a3ull
+#define WY_P3 0x4d5a2da51de1aa47ull
+
+uint64_t _wyMix(uint64_t a, uint64_t b) {
+    __uint128_t r = (__uint128_t)a * b;
+    return (uint64_t)r ^ (uint64_t)(r >> 64);
+}
+
+uint64_t _read64(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+uint64_t _read32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+// same structure as wyhash: 8 byte reads folded with 64x64->128 bit multiplications
+uint64_t HashWy(const char* key, size_t len, uint64_t seed) {
+    const uint8_t* p = (const uint8_t*)key;
+    uint64_t a, b;
+    seed ^= _wyMix(seed ^ WY_P0, WY_P1);
+    if (len <= 16) {
+        if (len >= 4) {
+            size_t middle = (len >> 3) << 2;
+            a = (_read32(p) << 32) | _read32(p + middle);
+            b = (_read32(p + len - 4) << 32) | _read32(p + len - 4 - middle);
+        }
+        else if (len > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+            b = 0;
+        }
+        else {
+            a = b = 0;
+        }
+    }
+    else {
+        size_t i = len;
+        if (i > 48) {
+            uint64_t seed1 = seed, seed2 = seed;
+            do {
+                seed = _wyMix(_read64(p) ^ WY_P1, _read64(p + 8) ^ seed);
+                seed1 = _wyMix(_read64(p + 16) ^ WY_P2, _read64(p + 24) ^ seed1);
+                seed2 = _wyMix(_read64(p + 32) ^ WY_P3, _read64(p + 40) ^ seed2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (i > 16) {
+            seed = _wyMix(_read64(p) ^ WY_P1, _read64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = _read64(p + i - 16);
+        b = _read64(p + i - 8);
+    }
+    a ^= WY_P1;
+    b ^= seed;
+    __uint128_t r = (__uint128_t)a * b;
+    a = (uint64_t)r;
+    b = (uint64_t)(r >> 64);
+    return _wyMix(a ^ WY_P0 ^ len, b ^ WY_P1);
+}
+
+uint64_t RandomSeed() {
+    uint64_t seed = 0;
+#ifdef __linux__
+    if (getrandom(&seed, sizeof(seed), 0) == sizeof(seed)) {
+        return seed;
+    }
+#endif
+    // fallback when the OS has no random source for us
+    static uint64_t counter = 0;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    seed = (uint64_t)ts.tv_nsec ^ ((uint64_t)ts.tv_sec << 32) ^ (uint64_t)(uintptr_t)&seed ^ ++counter;
+    return _wyMix(seed ^ WY_P0, WY_P1);
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+
+typedef uint64_t(*HashFunction)(const char* key, size_t len, uint64_t seed);
+
+uint64_t HashPolynomial(const char* key, size_t len, uint64_t seed);
+uint64_t HashFnv1a(const char* key, size_t len, uint64_t seed);
+uint64_t HashWy(const char* key, size_t len, uint64_t seed);
+
+uint64_t RandomSeed();
@@ -3,130 +3,282 @@
 #include <string.h>
 #include "hash_table.h"
 
+const char* HashTableStatusString(HashTableStatus status) {
+    switch (status) {
+    case HASH_TABLE_OK: return "ok";
+    case HASH_TABLE_NOT_FOUND: return "key not found";
+    case HASH_TABLE_BAD_ARGUMENT: return "bad values provided";
+    case HASH_TABLE_TOO_LONG: return "key or value exceeds max length";
+    case HASH_TABLE_NO_MEMORY: return "could not allocate memory";
+    }
+    return "unknown status";
+}
+
 Node* CreateNode(char* key, char* value) {
+    return _createNode(NULL, key, value);
+}
+
+Node* _createNode(HashTable* hashTable, char* key, char* value) {
     if (key == NULL || value == NULL) {
-        printf("error: key and value must be string\n");
+        LOG("error: key and value must be string");
+        if (hashTable != NULL) hashTable->lastStatus = HASH_TABLE_BAD_ARGUMENT;
         return NULL;
     }
 
-    if (strlen(key) > MAX_KEY_LEN || strlen(value) > MAX_VALUE_LEN) {
-        printf("error: key and value should not exceed max lengths\n");
+    size_t keyLen = strlen(key);
+    size_t valueLen = strlen(value);
+    if (keyLen > MAX_KEY_LEN || valueLen > MAX_VALUE_LEN) {
+        LOG("error: key and value should not exceed max lengths");
+        if (hashTable != NULL) hashTable->lastStatus = HASH_TABLE_TOO_LONG;
         return NULL;
     }
 
-    Node* newNode = malloc(sizeof(Node));
+    size_t size = sizeof(Node) + keyLen + valueLen + 2;
+    Pool* pool = hashTable == NULL ? NULL : hashTable->nodePool;
+    bool pooled = pool != NULL && size <= pool->objectSize;
+    Node* newNode = pooled ? PoolAlloc(pool) : malloc(size);
     if (newNode == NULL) {
-        printf("error: could not allocate memory for new node\n");
+        LOG("error: could not allocate memory for new node");
+        if (hashTable != NULL) hashTable->lastStatus = HASH_TABLE_NO_MEMORY;
         return NULL;
     }
+    if (!pooled && hashTable != NULL) {
+        hashTable->heapNodes += 1;
+    }
     newNode->next = NULL;
-    strcpy(newNode->key, key);
-    strcpy(newNode->value, value);
+    newNode->pooled = pooled;
+    newNode->hash = 0;
+    newNode->keyLen = keyLen;
+    newNode->valueLen = valueLen;
+    // a pooled node may have room to spare, and all of it can hold the value
+    newNode->valueCapacity = pooled ? pool->objectSize - sizeof(Node) - keyLen - 2 : valueLen;
+    memcpy(NodeKey(newNode), key, keyLen + 1);
+    memcpy(NodeValue(newNode), value, valueLen + 1);
     return newNode;
 };
 
-unsigned int ClearList(Node** headNode) {
-    Node* head = *headNode;
+void _releaseNode(HashTable* hashTable, Node* node) {
+    if (node->pooled) {
+        // without the table there is no way to know the pool, so the node is
+        // left to it, like DestroyHashTable does, until the pool is reset
+        if (hashTable != NULL) {
+            PoolFree(hashTable->nodePool, node);
+        }
+        return;
+    }
+    free(node);
+    if (hashTable != NULL) {
+        hashTable->heapNodes -= 1;
+    }
+}
+
+bool UpdateNodeValue(Node** nodeP, char* value) {
+    return _updateNodeValue(NULL, nodeP, value);
+}
+
+bool _updateNodeValue(HashTable* hashTable, Node** nodeP, char* value) {
+    if (nodeP == NULL || *nodeP == NULL || value == NULL) {
+        LOG("error: bad values provided");
+        if (hashTable != NULL) hashTable->lastStatus = HASH_TABLE_BAD_ARGUMENT;
+        return false;
+    }
+    Node* node = *nodeP;
+    size_t valueLen = strlen(value);
+    if (valueLen <= node->valueCapacity) {
+        memcpy(NodeValue(node), value, valueLen + 1);
+        node->valueLen = valueLen;
+        return true;
+    }
+    if (node->pooled && hashTable == NULL) {
+        // the bigger node would not be accounted for by the table that owns it
+        LOG("error: a pooled node can only grow through its table");
+        return false;
+    }
+
+    // the new value does not fit, so the node is replaced by a bigger one
+    Node* newNode = _createNode(hashTable, NodeKey(node), value);
+    if (newNode == NULL) {
+        return false;
+    }
+    newNode->next = node->next;
+    newNode->hash = node->hash;
+    *nodeP = newNode;
+    _releaseNode(hashTable, node);
+    return true;
+}
+
+unsigned int _freeList(HashTable* hashTable, Node* head) {
     Node* tmp;
     unsigned int deletedNodes = 0;
     while (head != NULL) {
         tmp = head;
         head = head->next;
-        free(tmp);
+        _releaseNode(hashTable, tmp);
         deletedNodes++;
     }
+    return deletedNodes;
+}
+
+void _freeHeapNodes(Node* head) {
+    while (head != NULL) {
+        Node* next = head->next;
+        if (!head->pooled) {
+            free(head);
+        }
+        head = next;
+    }
+}
+
+unsigned int ClearList(Node** headNode) {
+    unsigned int deletedNodes = _freeList(NULL, *headNode);
     *headNode = NULL;
-    printf("deleted %d nodes, linked list is now empty\n", deletedNodes);
+    LOG("deleted %u nodes, linked list is now empty", deletedNodes);
     return deletedNodes;
 };
 
 bool RemoveNode(Node** headP, char* key) {
     if (headP == NULL || *headP == NULL) {
-        printf("could not remove node, the list is empty\n");
+        LOG("could not remove node, the list is empty");
         return false;
     }
     Node* currentNode = *headP;
 
-    if (strcmp(currentNode->key, key) == 0) {
+    if (strcmp(NodeKey(currentNode), key) == 0) {
         *headP = currentNode->next;
-        free(currentNode);
+        _releaseNode(NULL, currentNode);
         return true;
     }
 
     Node* nextNode = currentNode->next;
 
     while (nextNode != NULL) {
-        if (strcmp(nextNode->key, key) == 0) {
+        if (strcmp(NodeKey(nextNode), key) == 0) {
             currentNode->next = nextNode->next;
-            free(nextNode);
+            _releaseNode(NULL, nextNode);
             return true;
         }
         currentNode = nextNode;
         nextNode = nextNode->next;
     }
-    printf("node of key %s could not be found\n", key);
+    LOG("node of key %s could not be found", key);
     return false;
 };
 
+Node* FindNode(Node* head, char* key) {
+    Node* tmp = head;
+    while (tmp != NULL && strcmp(NodeKey(tmp), key) != 0) {
+        tmp = tmp->next;
+    }
+    return tmp;
+}
+
 char* GetNodeValue(Node* head, char* key) {
     if (head == NULL) {
-        printf("could not find node because the list was empty\n");
+        LOG("could not find node because the list was empty");
         return NULL;
     }
 
     if (key == NULL) {
-        printf("cant check for node value due to nil key\n");
+        LOG("cant check for node value due to nil key");
         return NULL;
     }
-    Node* tmp = head;
-    while (tmp != NULL && strcmp(tmp->key, key) != 0) {
-        tmp = tmp->next;
-    }
+    Node* tmp = FindNode(head, key);
     if (tmp == NULL) {
         return NULL;
     }
 
-    char* buff = malloc(strlen(tmp->value) * sizeof(char*));
+    char* buff = malloc(tmp->valueLen + 1);
 
     if (buff == NULL) {
         return NULL;
     }
-    strcpy(buff, tmp->value);
+    memcpy(buff, NodeValue(tmp), tmp->valueLen + 1);
     return buff;
 }
 
-HashTable* CreateHashTable(unsigned int capacity) {
+unsigned int _roundCapacity(unsigned int capacity) {
     if (capacity < 4) {
-        capacity = 10;
+        capacity = INITIAL_CAPACITY;
+    }
+    unsigned int rounded = 1;
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+    return rounded;
+}
+
+HashTable* CreateHashTable(unsigned int capacity) {
+    return CreateHashTableWithHash(capacity, HashWy, RandomSeed());
+}
+
+HashTable* CreateHashTableWithPool(unsigned int capacity, Pool* nodePool) {
+    HashTable* hashTable = CreateHashTable(capacity);
+    if (hashTable != NULL) {
+        hashTable->nodePool = nodePool;
+    }
+    return hashTable;
+}
+
+HashTable* CreateHashTableWithHash(unsigned int capacity, HashFunction hashFunction, uint64_t seed) {
+    if (hashFunction == NULL) {
+        LOG("error: a hash function must be provided");
+        return NULL;
     }
+    capacity = _roundCapacity(capacity);
 
     Node** collection = calloc(capacity, sizeof(Node*));
     if (collection == NULL) {
-        printf("error: could not initialize underlying collection\n");
+        LOG("error: could not initialize underlying collection");
         return NULL;
     }
     HashTable* hashTable = malloc(sizeof(HashTable));
     if (hashTable == NULL) {
-        printf("error: could not initialize hash table\n");
+        LOG("error: could not initialize hash table");
         free(collection);
         return NULL;
     }
     hashTable->collection = collection;
     hashTable->capacity = capacity;
     hashTable->storedElements = 0;
+    hashTable->oldCollection = NULL;
+    hashTable->oldCapacity = 0;
+    hashTable->rehashIndex = 0;
+    hashTable->hashFunction = hashFunction;
+    hashTable->seed = seed;
+    hashTable->nodePool = NULL;
+    hashTable->heapNodes = 0;
+    hashTable->lastStatus = HASH_TABLE_OK;
     return hashTable;
 }
 
-unsigned int _computeHash(char* key, unsigned int capacity) {
-    unsigned int hash = 0;
-    unsigned int counter = 0;
-    unsigned int primeNumber = 31;
-    while (key[counter] != '\0') {
-        hash = (hash * primeNumber) + key[counter];
-        hash = hash % capacity;
-        counter++;
+void DestroyHashTable(HashTable** hashTableP) {
+    if (hashTableP == NULL || *hashTableP == NULL) {
+        return;
     }
-    return hash;
+    HashTable* hashTable = *hashTableP;
+    unsigned int i;
+    // pooled nodes are left to the pool, so when every node came from it
+    // there is no need to walk the chains at all
+    if (hashTable->heapNodes > 0) {
+        for (i = 0; i < hashTable->capacity; i++) {
+            _freeHeapNodes(hashTable->collection[i]);
+        }
+        for (i = 0; i < hashTable->oldCapacity; i++) {
+            _freeHeapNodes(hashTable->oldCollection[i]);
+        }
+    }
+    free(hashTable->collection);
+    free(hashTable->oldCollection);
+    free(hashTable);
+    *hashTableP = NULL;
+}
+
+uint64_t _computeHash(HashTable* hashTable, char* key) {
+    return hashTable->hashFunction(key, strlen(key), hashTable->seed);
+}
+
+unsigned int _bucketIndex(uint64_t hash, unsigned int capacity) {
+    return hash & (capacity - 1);
 }
 
 bool _needsToResize(HashTable* hashTable) {
@@ -137,116 +289,279 @@ bool _needsToResize(HashTable* hashTable) {
     return false;
 };
 
-HashTable* _resize(HashTable* hashTable) {
-    HashTable* oldHashTable = hashTable;
-    HashTable* newHashTable = CreateHashTable(oldHashTable->capacity * GROWTH_FACTOR);
-
-    unsigned int i;
-    bool success = true;
-    for (i = 0; i < oldHashTable->capacity; i++) {
-        Node* currentNode = oldHashTable->collection[i];
+bool _isRehashing(HashTable* hashTable) {
+    return hashTable->oldCollection != NULL;
+}
 
+void _rehashStep(HashTable* hashTable, unsigned int buckets) {
+    if (!_isRehashing(hashTable)) return;
+    while (buckets > 0 && hashTable->rehashIndex < hashTable->oldCapacity) {
+        Node* currentNode = hashTable->oldCollection[hashTable->rehashIndex];
         while (currentNode != NULL) {
-            success = Store(&newHashTable, currentNode->key, currentNode->value);
-            if (!success) break;
-            currentNode = currentNode->next;
+            Node* next = currentNode->next;
+            unsigned int position = _bucketIndex(currentNode->hash, hashTable->capacity);
+            currentNode->next = hashTable->collection[position];
+            hashTable->collection[position] = currentNode;
+            currentNode = next;
         }
+        hashTable->oldCollection[hashTable->rehashIndex] = NULL;
+        hashTable->rehashIndex++;
+        buckets--;
+    }
+    if (hashTable->rehashIndex == hashTable->oldCapacity) {
+        free(hashTable->oldCollection);
+        hashTable->oldCollection = NULL;
+        hashTable->oldCapacity = 0;
+        hashTable->rehashIndex = 0;
+    }
+}
 
-        if (!success) {
-            printf("error: could not complete sesizing\n");
-            break;
-        }
+bool _resize(HashTable* hashTable) {
+    // a previous migration still in flight is finished before starting a new one
+    _rehashStep(hashTable, hashTable->oldCapacity);
+
+    unsigned int newCapacity = hashTable->capacity * GROWTH_FACTOR;
+    Node** collection = calloc(newCapacity, sizeof(Node*));
+    if (collection == NULL) {
+        LOG("error: could not allocate the new collection");
+        return false;
     }
+    hashTable->oldCollection = hashTable->collection;
+    hashTable->oldCapacity = hashTable->capacity;
+    hashTable->rehashIndex = 0;
+    hashTable->collection = collection;
+    hashTable->capacity = newCapacity;
+    return true;
+};
 
-    if (success) {
-        int i;
-        for (i = 0; i < oldHashTable->capacity; i++) {
-            ClearList(&hashTable->collection[i]);
-        }
-        free(oldHashTable->collection);
-        free(oldHashTable);
-        printf("success!!\n");
-        return newHashTable;
-    }
-    printf("cleaning up after resizing attempt\n");
-    for (i = 0; i < newHashTable->capacity; i++) {
-        Node* currentNode = newHashTable->collection[i];
-        while (currentNode != NULL) {
-            Node* tmp = currentNode->next;
-            free(currentNode);
-            currentNode = tmp;
-        }
+Node** _findLink(HashTable* hashTable, char* key, uint64_t hash) {
+    Node** link = &hashTable->collection[_bucketIndex(hash, hashTable->capacity)];
+    while (*link != NULL) {
+        if ((*link)->hash == hash && strcmp(NodeKey(*link), key) == 0) return link;
+        link = &(*link)->next;
+    }
+    if (!_isRehashing(hashTable)) return NULL;
+
+    unsigned int oldPosition = _bucketIndex(hash, hashTable->oldCapacity);
+    if (oldPosition < hashTable->rehashIndex) return NULL;
+    link = &hashTable->oldCollection[oldPosition];
+    while (*link != NULL) {
+        if ((*link)->hash == hash && strcmp(NodeKey(*link), key) == 0) return link;
+        link = &(*link)->next;
     }
-    free(newHashTable->collection);
-    free(newHashTable);
     return NULL;
-};
+}
 
 bool Store(HashTable** hashTableP, char* key, char* value) {
 
-    if (hashTableP == NULL || *hashTableP == NULL || key == NULL || value == NULL) {
-        printf("error: bad values provided\n");
+    if (hashTableP == NULL || *hashTableP == NULL) {
+        LOG("error: bad values provided");
         return false;
     }
     HashTable* hashTable = *hashTableP;
-    if (_needsToResize(hashTable)) {
-        printf("needs to resize\n");
-        HashTable* newHashTable = _resize(hashTable);
-        if (newHashTable != NULL) {
-            *hashTableP = newHashTable;
-            hashTable = newHashTable;
-        }
-        else printf("error: could not resize hash table, we will try on next Store operation\n");
-
+    if (key == NULL || value == NULL) {
+        LOG("error: bad values provided");
+        hashTable->lastStatus = HASH_TABLE_BAD_ARGUMENT;
+        return false;
     }
+    return _storeHashed(hashTable, key, value, _computeHash(hashTable, key));
+}
 
-    unsigned int position = _computeHash(key, hashTable->capacity);
-
-    Node* head = hashTable->collection[position];
+bool _storeHashed(HashTable* hashTable, char* key, char* value, uint64_t hash) {
+    _rehashStep(hashTable, REHASH_BUCKETS_PER_STEP);
 
-    while (head != NULL) {
-        if (strcmp(head->key, key) == 0) {
-            break;
-        }
-        head = head->next;
+    Node** link = _findLink(hashTable, key, hash);
+    if (link != NULL) {
+        if (!_updateNodeValue(hashTable, link, value)) return false;
+        hashTable->lastStatus = HASH_TABLE_OK;
+        return true;
     }
 
-    if (head != NULL) {
-        strcpy(head->value, value);
-        return true;
+    if (_needsToResize(hashTable)) {
+        LOG("needs to resize");
+        if (!_resize(hashTable)) {
+            LOG("error: could not resize hash table, we will try on next Store operation");
+        }
     }
 
-    Node* newNode = CreateNode(key, value);
+    Node* newNode = _createNode(hashTable, key, value);
 
     if (newNode == NULL) {
-        printf("error: could not alocate memory for node\n");
         return false;
     }
+    unsigned int position = _bucketIndex(hash, hashTable->capacity);
+    newNode->hash = hash;
     newNode->next = hashTable->collection[position];
     hashTable->collection[position] = newNode;
     hashTable->storedElements += 1;
+    hashTable->lastStatus = HASH_TABLE_OK;
     return true;
 }
 
+void _prefetchBuckets(HashTable* hashTable, uint64_t* hashes, unsigned int count) {
+    unsigned int i;
+    for (i = 0; i < count; i++) {
+        __builtin_prefetch(&hashTable->collection[_bucketIndex(hashes[i], hashTable->capacity)]);
+        if (_isRehashing(hashTable)) {
+            __builtin_prefetch(&hashTable->oldCollection[_bucketIndex(hashes[i], hashTable->oldCapacity)]);
+        }
+    }
+}
+
+bool StoreMany(HashTable** hashTableP, char** keys, char** values, unsigned int count) {
+    if (hashTableP == NULL || *hashTableP == NULL) {
+        LOG("error: bad values provided");
+        return false;
+    }
+    HashTable* hashTable = *hashTableP;
+    if (keys == NULL || values == NULL) {
+        LOG("error: bad values provided");
+        hashTable->lastStatus = HASH_TABLE_BAD_ARGUMENT;
+        return false;
+    }
+    uint64_t hashes[BATCH_SIZE];
+    HashTableStatus failure = HASH_TABLE_OK;
+    unsigned int start, i;
+    for (start = 0; start < count; start += BATCH_SIZE) {
+        unsigned int batch = count - start < BATCH_SIZE ? count - start : BATCH_SIZE;
+        for (i = 0; i < batch; i++) {
+            if (keys[start + i] == NULL || values[start + i] == NULL) {
+                LOG("error: bad values provided");
+                hashTable->lastStatus = HASH_TABLE_BAD_ARGUMENT;
+                return false;
+            }
+            hashes[i] = _computeHash(hashTable, keys[start + i]);
+        }
+        _prefetchBuckets(hashTable, hashes, batch);
+        for (i = 0; i < batch; i++) {
+            if (!_storeHashed(hashTable, keys[start + i], values[start + i], hashes[i])) {
+                failure = hashTable->lastStatus;
+            }
+        }
+    }
+    // the status of the batch is the one of its last failure, if any
+    hashTable->lastStatus = failure;
+    return failure == HASH_TABLE_OK;
+}
+
+unsigned int GetMany(HashTable* hashTable, char** keys, unsigned int count, ValueView* views) {
+    if (hashTable == NULL) {
+        LOG("error: bad values provided");
+        return 0;
+    }
+    if (keys == NULL || views == NULL) {
+        LOG("error: bad values provided");
+        hashTable->lastStatus = HASH_TABLE_BAD_ARGUMENT;
+        return 0;
+    }
+    uint64_t hashes[BATCH_SIZE];
+    unsigned int found = 0;
+    bool badKey = false;
+    unsigned int start, i;
+    for (start = 0; start < count; start += BATCH_SIZE) {
+        unsigned int batch = count - start < BATCH_SIZE ? count - start : BATCH_SIZE;
+        for (i = 0; i < batch; i++) {
+            // a NULL key gets a dummy hash here and is reported as missing below
+            hashes[i] = keys[start + i] == NULL ? 0 : _computeHash(hashTable, keys[start + i]);
+        }
+        _prefetchBuckets(hashTable, hashes, batch);
+        // by now the bucket heads are arriving, so ask for the first nodes too
+        for (i = 0; i < batch; i++) {
+            Node* head = hashTable->collection[_bucketIndex(hashes[i], hashTable->capacity)];
+            if (head != NULL) {
+                __builtin_prefetch(head);
+            }
+        }
+        for (i = 0; i < batch; i++) {
+            Node** link = NULL;
+            if (keys[start + i] == NULL) {
+                LOG("error: bad values provided");
+                badKey = true;
+            } else {
+                link = _findLink(hashTable, keys[start + i], hashes[i]);
+            }
+            if (link == NULL) {
+                views[start + i].data = NULL;
+                views[start + i].len = 0;
+                continue;
+            }
+            views[start + i].data = NodeValue(*link);
+            views[start + i].len = (*link)->valueLen;
+            found++;
+        }
+    }
+    hashTable->lastStatus = badKey ? HASH_TABLE_BAD_ARGUMENT
+        : found == count ? HASH_TABLE_OK : HASH_TABLE_NOT_FOUND;
+    return found;
+}
+
 char* Get(HashTable* hashTable, char* key) {
-    if (hashTable == NULL || key == NULL || strlen(key) == 0) {
-        printf("error: bad values were provided:\n%p\n%s\n%ld\n", hashTable, key, strlen(key));
+    ValueView view;
+    if (!GetView(hashTable, key, &view)) return NULL;
+    char* value = malloc(view.len + 1);
+    if (value == NULL) {
+        LOG("error: could not allocate memory for value");
+        hashTable->lastStatus = HASH_TABLE_NO_MEMORY;
         return NULL;
     }
-    unsigned int position = _computeHash(key, hashTable->capacity);
-    Node* head = hashTable->collection[position];
-    if (head == NULL) return NULL;
-    char* value = GetNodeValue(head, key);
+    memcpy(value, view.data, view.len + 1);
     return value;
 };
 
+bool GetView(HashTable* hashTable, char* key, ValueView* view) {
+    if (hashTable == NULL) {
+        LOG("error: bad values provided");
+        return false;
+    }
+    if (key == NULL || view == NULL) {
+        LOG("error: bad values provided");
+        hashTable->lastStatus = HASH_TABLE_BAD_ARGUMENT;
+        return false;
+    }
+    Node** link = _findLink(hashTable, key, _computeHash(hashTable, key));
+    if (link == NULL) {
+        hashTable->lastStatus = HASH_TABLE_NOT_FOUND;
+        return false;
+    }
+    view->data = NodeValue(*link);
+    view->len = (*link)->valueLen;
+    hashTable->lastStatus = HASH_TABLE_OK;
+    return true;
+}
+
+bool GetInto(HashTable* hashTable, char* key, char* buffer, size_t bufferLen, size_t* valueLen) {
+    ValueView view;
+    if (!GetView(hashTable, key, &view)) return false;
+    if (valueLen != NULL) {
+        *valueLen = view.len;
+    }
+    if (buffer == NULL || bufferLen == 0) return true;
+    size_t toCopy = view.len < bufferLen - 1 ? view.len : bufferLen - 1;
+    memcpy(buffer, view.data, toCopy);
+    buffer[toCopy] = '\0';
+    return true;
+}
+
 bool Remove(HashTable* hashTable, char* key) {
-    if (hashTable == NULL || key == NULL || strlen(key) == 0) {
-        printf("error: bad values were provided:\n%p\n%s\n%ld\n", hashTable, key, strlen(key));
+    if (hashTable == NULL) {
+        LOG("error: bad values provided");
+        return false;
+    }
+    if (key == NULL || strlen(key) == 0) {
+        LOG("error: bad values provided");
+        hashTable->lastStatus = HASH_TABLE_BAD_ARGUMENT;
+        return false;
+    }
+    _rehashStep(hashTable, REHASH_BUCKETS_PER_STEP);
+    Node** link = _findLink(hashTable, key, _computeHash(hashTable, key));
+    if (link == NULL) {
+        hashTable->lastStatus = HASH_TABLE_NOT_FOUND;
         return false;
     }
-    unsigned int position = _computeHash(key, hashTable->capacity);
-    if (hashTable->collection[position] == NULL) return true;
-    bool success = RemoveNode(&hashTable->collection[position], key);
-    return success;
+    Node* toDelete = *link;
+    *link = toDelete->next;
+    _releaseNode(hashTable, toDelete);
+    hashTable->storedElements -= 1;
+    hashTable->lastStatus = HASH_TABLE_OK;
+    return true;
 };
\ No newline at end of file
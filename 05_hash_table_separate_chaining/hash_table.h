@@ -3,37 +3,124 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
+#include "hash_functions.h"
+#include "pool.h"
+#include "log.h"
 
 
-#define MAX_KEY_LEN 256
-#define MAX_VALUE_LEN 256
+#define MAX_KEY_LEN UINT16_MAX
+#define MAX_VALUE_LEN (1u << 30)
 #define INITIAL_CAPACITY 10
 #define GROWTH_FACTOR 2
+#define REHASH_BUCKETS_PER_STEP 4
+#define BATCH_SIZE 32
 
+// outcome of the last operation on a table, kept in lastStatus
+typedef enum {
+    HASH_TABLE_OK,
+    HASH_TABLE_NOT_FOUND,
+    HASH_TABLE_BAD_ARGUMENT,
+    HASH_TABLE_TOO_LONG,
+    HASH_TABLE_NO_MEMORY,
+} HashTableStatus;
 
+
+// key and value live right after the node, in the same allocation, as
+// key\0value\0, so a node only takes as much memory as its strings need
+// and NodeKey/NodeValue find them from keyLen. valueCapacity is the longest
+// value the node has room for, which stays put when a shorter value is
+// stored, so growing back does not need a new node.
+// hash is the full hash of the key, set by the table that owns the node
 typedef struct Node_T {
-    char key[MAX_KEY_LEN];
-    char value[MAX_VALUE_LEN];
     struct Node_T* next;
+    uint64_t hash;
+    uint16_t keyLen;
+    bool pooled;
+    uint32_t valueLen;
+    uint32_t valueCapacity;
+    char data[];
 } Node;
 
+static inline char* NodeKey(Node* node) {
+    return node->data;
+}
+
+static inline char* NodeValue(Node* node) {
+    return node->data + node->keyLen + 1;
+}
+
+// a borrowed view of a stored value, it stays valid until the next
+// Store or Remove on the same table, or until the table is freed
+typedef struct {
+    const char* data;
+    uint32_t len;
+} ValueView;
+
+// while growing, entries are migrated from oldCollection a few buckets
+// per Store/Remove, buckets below rehashIndex have already been moved.
+// When nodePool is set, nodes that fit in one of its objects come from it
+// and the rest from malloc, heapNodes counts the latter. The pool must
+// outlive the table: DestroyHashTable leaves pooled nodes to the pool,
+// and resetting or destroying the pool releases them all at once
 typedef struct {
     Node** collection;
     unsigned int capacity;
     unsigned int storedElements;
+    Node** oldCollection;
+    unsigned int oldCapacity;
+    unsigned int rehashIndex;
+    HashFunction hashFunction;
+    uint64_t seed;
+    Pool* nodePool;
+    unsigned int heapNodes;
+    HashTableStatus lastStatus;
 } HashTable;
 
+const char* HashTableStatusString(HashTableStatus status);
+
+// the list functions do not know which table a node belongs to, so they
+// never free pooled nodes: removed ones are left to their pool, and a pooled
+// node whose new value does not fit is refused by UpdateNodeValue
 Node* CreateNode(char* key, char* value);
+bool UpdateNodeValue(Node** nodeP, char* value);
 bool RemoveNode(Node** head, char* key);
 unsigned int ClearList(Node** headNode);
+Node* FindNode(Node* head, char* key);
 char* GetNodeValue(Node* head, char* key);
 
 
 HashTable* CreateHashTable(unsigned int capacity);
+HashTable* CreateHashTableWithPool(unsigned int capacity, Pool* nodePool);
+HashTable* CreateHashTableWithHash(unsigned int capacity, HashFunction hashFunction, uint64_t seed);
+void DestroyHashTable(HashTable** hashTableP);
 bool Store(HashTable** hashTable, char* key, char* value);
 char* Get(HashTable* hashTable, char* key);
+bool GetView(HashTable* hashTable, char* key, ValueView* view);
+// copies at most bufferLen - 1 bytes plus a terminator, like snprintf,
+// valueLen always receives the full length so truncation can be detected
+bool GetInto(HashTable* hashTable, char* key, char* buffer, size_t bufferLen, size_t* valueLen);
 bool Remove(HashTable* hashTable, char* key);
 
-unsigned int _computeHash(char* key, unsigned int capacity);
+// batched versions hash BATCH_SIZE keys, prefetch their buckets and only
+// then walk the chains, so the cache misses of different keys overlap.
+// GetMany fills one view per key (data is NULL when the key is missing or
+// NULL, the latter also sets HASH_TABLE_BAD_ARGUMENT),
+// views follow the same lifetime rules as GetView
+bool StoreMany(HashTable** hashTableP, char** keys, char** values, unsigned int count);
+unsigned int GetMany(HashTable* hashTable, char** keys, unsigned int count, ValueView* views);
+
+unsigned int _roundCapacity(unsigned int capacity);
+uint64_t _computeHash(HashTable* hashTable, char* key);
+unsigned int _bucketIndex(uint64_t hash, unsigned int capacity);
 bool _needsToResize(HashTable* hashTable);
-HashTable* _resize(HashTable* hashTable);
+bool _resize(HashTable* hashTable);
+bool _isRehashing(HashTable* hashTable);
+void _rehashStep(HashTable* hashTable, unsigned int buckets);
+Node** _findLink(HashTable* hashTable, char* key, uint64_t hash);
+unsigned int _freeList(HashTable* hashTable, Node* head);
+void _freeHeapNodes(Node* head);
+Node* _createNode(HashTable* hashTable, char* key, char* value);
+void _releaseNode(HashTable* hashTable, Node* node);
+bool _updateNodeValue(HashTable* hashTable, Node** nodeP, char* value);
+bool _storeHashed(HashTable* hashTable, char* key, char* value, uint64_t hash);
+void _prefetchBuckets(HashTable* hashTable, uint64_t* hashes, unsigned int count);
@@ -0,0 +1,290 @@
+#include <stdbool.h>
+#include <string.h>
+#include "open_addressing.h"
+
+unsigned int _openRoundCapacity(unsigned int capacity) {
+    unsigned int rounded = OPEN_INITIAL_CAPACITY;
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+    return rounded;
+}
+
+OpenHashTable* CreateOpenHashTable(unsigned int capacity) {
+    capacity = _openRoundCapacity(capacity);
+
+    uint8_t* meta = calloc(capacity, sizeof(uint8_t));
+    OpenSlot* slots = malloc(capacity * sizeof(OpenSlot));
+    OpenHashTable* table = malloc(sizeof(OpenHashTable));
+    if (meta == NULL || slots == NULL || table == NULL) {
+        LOG("error: could not initialize open addressing hash table");
+        free(meta);
+        free(slots);
+        free(table);
+        return NULL;
+    }
+    table->meta = meta;
+    table->slots = slots;
+    table->data = NULL;
+    table->dataLen = 0;
+    table->dataCapacity = 0;
+    table->capacity = capacity;
+    table->storedElements = 0;
+    return table;
+}
+
+void DestroyOpenHashTable(OpenHashTable** tableP) {
+    if (tableP == NULL || *tableP == NULL) {
+        return;
+    }
+    OpenHashTable* table = *tableP;
+    free(table->data);
+    free(table->meta);
+    free(table->slots);
+    free(table);
+    *tableP = NULL;
+}
+
+uint32_t _openComputeHash(char* key, uint32_t keyLen) {
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+    for (i = 0; i < keyLen; i++) {
+        hash ^= (uint8_t)key[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+int64_t _openFind(OpenHashTable* table, char* key, uint32_t keyLen, uint32_t hash) {
+    unsigned int mask = table->capacity - 1;
+    unsigned int position = hash & mask;
+    unsigned int distance = 0;
+    while (true) {
+        uint8_t meta = table->meta[position];
+        // robin hood invariant: once we meet an empty slot or an entry
+        // closer to its home than we are to ours, the key is not here
+        if (meta == 0 || (unsigned int)(meta - 1) < distance) {
+            return -1;
+        }
+        OpenSlot* slot = &table->slots[position];
+        if (slot->hash == hash && slot->keyLen == keyLen && memcmp(table->data + slot->offset, key, keyLen) == 0) {
+            return position;
+        }
+        position = (position + 1) & mask;
+        distance++;
+    }
+}
+
+bool _openInsertSlot(OpenHashTable* table, OpenSlot* slot) {
+    unsigned int mask = table->capacity - 1;
+    unsigned int position = slot->hash & mask;
+    unsigned int distance = 0;
+    while (distance < OPEN_MAX_PROBE_DISTANCE) {
+        uint8_t meta = table->meta[position];
+        if (meta == 0) {
+            table->meta[position] = distance + 1;
+            table->slots[position] = *slot;
+            return true;
+        }
+        unsigned int residentDistance = meta - 1;
+        if (residentDistance < distance) {
+            OpenSlot tmp = table->slots[position];
+            table->slots[position] = *slot;
+            table->meta[position] = distance + 1;
+            *slot = tmp;
+            distance = residentDistance;
+        }
+        position = (position + 1) & mask;
+        distance++;
+    }
+    // the slot we hold now may be a displaced one, the caller grows the
+    // table and retries with it
+    return false;
+}
+
+bool _openResize(OpenHashTable* table, unsigned int newCapacity) {
+    while (true) {
+        OpenHashTable* newTable = CreateOpenHashTable(newCapacity);
+        if (newTable == NULL) {
+            return false;
+        }
+        unsigned int i;
+        bool success = true;
+        for (i = 0; i < table->capacity && success; i++) {
+            if (table->meta[i] == 0) continue;
+            OpenSlot slot = table->slots[i];
+            success = _openInsertSlot(newTable, &slot);
+        }
+
+        if (success) {
+            free(table->meta);
+            free(table->slots);
+            table->meta = newTable->meta;
+            table->slots = newTable->slots;
+            table->capacity = newTable->capacity;
+            free(newTable);
+            return true;
+        }
+        // data is shared with the old table, so only the arrays go away
+        free(newTable->meta);
+        free(newTable->slots);
+        free(newTable);
+        newCapacity *= 2;
+    }
+}
+
+// copies the live entries into a new buffer with room for at least extra
+// more bytes, leaving the dead ones behind
+bool _openRepackData(OpenHashTable* table, size_t extra) {
+    size_t live = 0;
+    unsigned int i;
+    for (i = 0; i < table->capacity; i++) {
+        if (table->meta[i] != 0) {
+            live += (size_t)table->slots[i].keyLen + table->slots[i].valueLen + 2;
+        }
+    }
+    if (extra > OPEN_MAX_DATA_LEN - live) {
+        return false;
+    }
+    // half of the new buffer is left free, so the appends that fill it
+    // pay for the next repack
+    size_t capacity = OPEN_INITIAL_DATA_CAPACITY;
+    while (capacity < (live + extra) * 2 && capacity < OPEN_MAX_DATA_LEN) {
+        capacity *= 2;
+    }
+    if (capacity > OPEN_MAX_DATA_LEN) {
+        capacity = OPEN_MAX_DATA_LEN;
+    }
+    char* data = malloc(capacity);
+    if (data == NULL) {
+        return false;
+    }
+    size_t dataLen = 0;
+    for (i = 0; i < table->capacity; i++) {
+        if (table->meta[i] == 0) continue;
+        OpenSlot* slot = &table->slots[i];
+        size_t size = (size_t)slot->keyLen + slot->valueLen + 2;
+        memcpy(data + dataLen, table->data + slot->offset, size);
+        slot->offset = dataLen;
+        dataLen += size;
+    }
+    free(table->data);
+    table->data = data;
+    table->dataLen = dataLen;
+    table->dataCapacity = capacity;
+    return true;
+}
+
+bool _openAppendEntry(OpenHashTable* table, char* key, uint32_t keyLen, char* value, uint32_t valueLen, uint32_t* offset) {
+    size_t size = (size_t)keyLen + valueLen + 2;
+    if (size > table->dataCapacity - table->dataLen && !_openRepackData(table, size)) {
+        return false;
+    }
+    char* entry = table->data + table->dataLen;
+    memcpy(entry, key, (size_t)keyLen + 1);
+    memcpy(entry + keyLen + 1, value, (size_t)valueLen + 1);
+    *offset = table->dataLen;
+    table->dataLen += size;
+    return true;
+}
+
+bool OpenStore(OpenHashTable* table, char* key, char* value) {
+    if (table == NULL || key == NULL || value == NULL) {
+        LOG("error: bad values provided");
+        return false;
+    }
+    size_t keyLen = strlen(key);
+    size_t valueLen = strlen(value);
+    if (keyLen + valueLen + 2 > OPEN_MAX_DATA_LEN) {
+        LOG("error: key and value are too long");
+        return false;
+    }
+    uint32_t hash = _openComputeHash(key, keyLen);
+
+    int64_t position = _openFind(table, key, keyLen, hash);
+    if (position >= 0) {
+        OpenSlot* slot = &table->slots[position];
+        // a value that fits where the old one was is written over it
+        if (valueLen <= slot->valueLen) {
+            memcpy(table->data + slot->offset + keyLen + 1, value, valueLen + 1);
+            slot->valueLen = valueLen;
+            return true;
+        }
+        uint32_t offset;
+        if (!_openAppendEntry(table, key, keyLen, value, valueLen, &offset)) {
+            LOG("error: could not allocate memory for entry");
+            return false;
+        }
+        slot->offset = offset;
+        slot->valueLen = valueLen;
+        return true;
+    }
+
+    if ((double)(table->storedElements + 1) > (double)table->capacity * OPEN_MAX_LOAD_FACTOR) {
+        if (!_openResize(table, table->capacity * 2)) {
+            LOG("error: could not resize open addressing hash table");
+            return false;
+        }
+    }
+
+    OpenSlot slot = { hash, keyLen, valueLen, 0 };
+    if (!_openAppendEntry(table, key, keyLen, value, valueLen, &slot.offset)) {
+        LOG("error: could not allocate memory for entry");
+        return false;
+    }
+    while (!_openInsertSlot(table, &slot)) {
+        if (!_openResize(table, table->capacity * 2)) {
+            LOG("error: could not resize open addressing hash table");
+            return false;
+        }
+    }
+    table->storedElements += 1;
+    return true;
+}
+
+char* OpenGet(OpenHashTable* table, char* key) {
+    if (table == NULL || key == NULL) {
+        LOG("error: bad values provided");
+        return NULL;
+    }
+    uint32_t keyLen = strlen(key);
+    int64_t position = _openFind(table, key, keyLen, _openComputeHash(key, keyLen));
+    if (position < 0) {
+        return NULL;
+    }
+    OpenSlot* slot = &table->slots[position];
+    char* buff = malloc(slot->valueLen + 1);
+    if (buff == NULL) {
+        return NULL;
+    }
+    memcpy(buff, table->data + slot->offset + keyLen + 1, slot->valueLen + 1);
+    return buff;
+}
+
+bool OpenRemove(OpenHashTable* table, char* key) {
+    if (table == NULL || key == NULL) {
+        LOG("error: bad values provided");
+        return false;
+    }
+    uint32_t keyLen = strlen(key);
+    int64_t found = _openFind(table, key, keyLen, _openComputeHash(key, keyLen));
+    if (found < 0) {
+        return false;
+    }
+    unsigned int mask = table->capacity - 1;
+    unsigned int position = found;
+
+    // backward shift deletion, no tombstones are left behind
+    while (true) {
+        unsigned int next = (position + 1) & mask;
+        if (table->meta[next] <= 1) {
+            table->meta[position] = 0;
+            break;
+        }
+        table->slots[position] = table->slots[next];
+        table->meta[position] = table->meta[next] - 1;
+        position = next;
+    }
+    table->storedElements -= 1;
+    return true;
+}
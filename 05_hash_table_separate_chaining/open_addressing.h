@@ -0,0 +1,51 @@
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "log.h"
+
+#define OPEN_INITIAL_CAPACITY 16
+#define OPEN_MAX_LOAD_FACTOR 0.875
+#define OPEN_MAX_PROBE_DISTANCE 254
+#define OPEN_INITIAL_DATA_CAPACITY 1024
+// offsets into data are 32 bits, like the lengths
+#define OPEN_MAX_DATA_LEN UINT32_MAX
+
+// meta[i] == 0 means the slot is empty, otherwise it holds
+// the distance from the slot to the key's home bucket plus one.
+// A slot keeps everything probing needs, the key bytes are only read
+// once hash and length match. They live at data + offset as key\0value\0
+typedef struct {
+    uint32_t hash;
+    uint32_t keyLen;
+    uint32_t valueLen;
+    uint32_t offset;
+} OpenSlot;
+
+// entries are appended to data instead of being allocated one by one.
+// Replaced and removed entries leave dead bytes behind, which are dropped
+// when data is full and gets repacked
+typedef struct {
+    uint8_t* meta;
+    OpenSlot* slots;
+    char* data;
+    size_t dataLen;
+    size_t dataCapacity;
+    unsigned int capacity;
+    unsigned int storedElements;
+} OpenHashTable;
+
+OpenHashTable* CreateOpenHashTable(unsigned int capacity);
+void DestroyOpenHashTable(OpenHashTable** tableP);
+bool OpenStore(OpenHashTable* table, char* key, char* value);
+char* OpenGet(OpenHashTable* table, char* key);
+bool OpenRemove(OpenHashTable* table, char* key);
+
+unsigned int _openRoundCapacity(unsigned int capacity);
+uint32_t _openComputeHash(char* key, uint32_t keyLen);
+int64_t _openFind(OpenHashTable* table, char* key, uint32_t keyLen, uint32_t hash);
+bool _openInsertSlot(OpenHashTable* table, OpenSlot* slot);
+bool _openResize(OpenHashTable* table, unsigned int newCapacity);
+bool _openRepackData(OpenHashTable* table, size_t extra);
+bool _openAppendEntry(OpenHashTable* table, char* key, uint32_t keyLen, char* value, uint32_t valueLen, uint32_t* offset);
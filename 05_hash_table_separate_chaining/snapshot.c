@@ -0,0 +1,264 @@
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "snapshot.h"
+
+unsigned int _snapshotCollectNodes(HashTable* hashTable, Node** nodes) {
+    unsigned int count = 0;
+    unsigned int i;
+    for (i = 0; i < hashTable->capacity; i++) {
+        Node* current;
+        for (current = hashTable->collection[i]; current != NULL; current = current->next) {
+            nodes[count++] = current;
+        }
+    }
+    // buckets below rehashIndex were already moved to the new collection
+    if (_isRehashing(hashTable)) {
+        for (i = hashTable->rehashIndex; i < hashTable->oldCapacity; i++) {
+            Node* current;
+            for (current = hashTable->oldCollection[i]; current != NULL; current = current->next) {
+                nodes[count++] = current;
+            }
+        }
+    }
+    return count;
+}
+
+bool SaveSnapshot(HashTable* hashTable, const char* path) {
+    if (hashTable == NULL || path == NULL) {
+        LOG("error: bad values provided");
+        return false;
+    }
+    uint64_t entryCount = hashTable->storedElements;
+    uint32_t bucketCount = _roundCapacity(hashTable->storedElements);
+    uint64_t seed = hashTable->seed;
+
+    Node** nodes = malloc((entryCount + 1) * sizeof(Node*));
+    uint64_t* hashes = malloc((entryCount + 1) * sizeof(uint64_t));
+    uint64_t* bucketStarts = calloc((size_t)bucketCount + 1, sizeof(uint64_t));
+    uint64_t* cursors = malloc(((size_t)bucketCount + 1) * sizeof(uint64_t));
+    SnapshotEntry* entries = malloc((entryCount + 1) * sizeof(SnapshotEntry));
+    Node** ordered = malloc((entryCount + 1) * sizeof(Node*));
+    if (nodes == NULL || hashes == NULL || bucketStarts == NULL || cursors == NULL || entries == NULL || ordered == NULL) {
+        LOG("error: could not allocate memory for snapshot");
+        free(nodes);
+        free(hashes);
+        free(bucketStarts);
+        free(cursors);
+        free(entries);
+        free(ordered);
+        return false;
+    }
+    _snapshotCollectNodes(hashTable, nodes);
+
+    // counting sort of the nodes by snapshot bucket, so a lookup only
+    // scans one contiguous run of entries
+    uint64_t i;
+    for (i = 0; i < entryCount; i++) {
+        Node* node = nodes[i];
+        hashes[i] = hashTable->hashFunction == HashWy ? node->hash : HashWy(NodeKey(node), node->keyLen, seed);
+        bucketStarts[(hashes[i] & (bucketCount - 1)) + 1]++;
+    }
+    for (i = 0; i < bucketCount; i++) {
+        bucketStarts[i + 1] += bucketStarts[i];
+    }
+    memcpy(cursors, bucketStarts, ((size_t)bucketCount + 1) * sizeof(uint64_t));
+    for (i = 0; i < entryCount; i++) {
+        uint64_t position = cursors[hashes[i] & (bucketCount - 1)]++;
+        ordered[position] = nodes[i];
+        entries[position].hash = hashes[i];
+    }
+    uint64_t dataSize = 0;
+    for (i = 0; i < entryCount; i++) {
+        entries[i].keyOffset = dataSize;
+        entries[i].keyLen = ordered[i]->keyLen;
+        entries[i].valueLen = ordered[i]->valueLen;
+        dataSize += (uint64_t)ordered[i]->keyLen + ordered[i]->valueLen + 2;
+    }
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.bucketCount = bucketCount;
+    header.entryCount = entryCount;
+    header.seed = seed;
+    header.entriesOffset = sizeof(SnapshotHeader) + ((uint64_t)bucketCount + 1) * sizeof(uint64_t);
+    header.dataOffset = header.entriesOffset + entryCount * sizeof(SnapshotEntry);
+    header.dataSize = dataSize;
+
+    // write next to the destination and rename over it, so processes
+    // mapping the previous snapshot never see a half written file
+    size_t pathLen = strlen(path);
+    char* tmpPath = malloc(pathLen + 5);
+    FILE* file = NULL;
+    bool success = tmpPath != NULL;
+    if (success) {
+        memcpy(tmpPath, path, pathLen);
+        memcpy(tmpPath + pathLen, ".tmp", 5);
+        file = fopen(tmpPath, "wb");
+        success = file != NULL;
+    }
+    if (success) {
+        success = fwrite(&header, sizeof(header), 1, file) == 1
+            && fwrite(bucketStarts, sizeof(uint64_t), (size_t)bucketCount + 1, file) == (size_t)bucketCount + 1
+            && fwrite(entries, sizeof(SnapshotEntry), entryCount, file) == entryCount;
+        for (i = 0; i < entryCount && success; i++) {
+            success = fwrite(NodeKey(ordered[i]), 1, ordered[i]->keyLen + 1, file) == (size_t)ordered[i]->keyLen + 1
+                && fwrite(NodeValue(ordered[i]), 1, ordered[i]->valueLen + 1, file) == (size_t)ordered[i]->valueLen + 1;
+        }
+        success = fflush(file) == 0 && fsync(fileno(file)) == 0 && success;
+        success = fclose(file) == 0 && success;
+        if (success) {
+            success = rename(tmpPath, path) == 0;
+        }
+        if (!success) {
+            unlink(tmpPath);
+        }
+    }
+    if (!success) {
+        LOG("error: could not write snapshot to %s", path);
+    }
+
+    free(tmpPath);
+    free(nodes);
+    free(hashes);
+    free(bucketStarts);
+    free(cursors);
+    free(entries);
+    free(ordered);
+    return success;
+}
+
+bool _snapshotValidate(const Snapshot* snapshot) {
+    const SnapshotHeader* header = snapshot->header;
+    if (snapshot->size < sizeof(SnapshotHeader)
+        || memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0
+        || header->version != SNAPSHOT_VERSION) {
+        return false;
+    }
+    if (header->bucketCount == 0 || (header->bucketCount & (header->bucketCount - 1)) != 0) {
+        return false;
+    }
+    uint64_t entriesOffset = sizeof(SnapshotHeader) + ((uint64_t)header->bucketCount + 1) * sizeof(uint64_t);
+    if (header->entriesOffset != entriesOffset || entriesOffset > snapshot->size) {
+        return false;
+    }
+    if (header->entryCount > (snapshot->size - entriesOffset) / sizeof(SnapshotEntry)) {
+        return false;
+    }
+    uint64_t dataOffset = entriesOffset + header->entryCount * sizeof(SnapshotEntry);
+    if (header->dataOffset != dataOffset || header->dataSize > snapshot->size - dataOffset) {
+        return false;
+    }
+    // the bucket runs themselves are checked lazily, by the lookups that use them
+    return snapshot->bucketStarts[header->bucketCount] == header->entryCount;
+}
+
+Snapshot* OpenSnapshot(const char* path) {
+    if (path == NULL) {
+        LOG("error: bad values provided");
+        return NULL;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        LOG("error: could not open snapshot %s", path);
+        return NULL;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(SnapshotHeader)) {
+        LOG("error: %s is not a snapshot", path);
+        close(fd);
+        return NULL;
+    }
+    // the mapping keeps the file alive, the descriptor is not needed anymore
+    void* base = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        LOG("error: could not map snapshot %s", path);
+        return NULL;
+    }
+    Snapshot* snapshot = malloc(sizeof(Snapshot));
+    if (snapshot == NULL) {
+        LOG("error: could not allocate memory for snapshot");
+        munmap(base, info.st_size);
+        return NULL;
+    }
+    snapshot->base = base;
+    snapshot->size = info.st_size;
+    snapshot->header = base;
+    snapshot->bucketStarts = (const uint64_t*)((const char*)base + sizeof(SnapshotHeader));
+    snapshot->entries = (const SnapshotEntry*)((const char*)base + snapshot->header->entriesOffset);
+    snapshot->data = (const char*)base + snapshot->header->dataOffset;
+    if (!_snapshotValidate(snapshot)) {
+        LOG("error: %s is not a valid snapshot", path);
+        CloseSnapshot(&snapshot);
+        return NULL;
+    }
+    return snapshot;
+}
+
+void CloseSnapshot(Snapshot** snapshotP) {
+    if (snapshotP == NULL || *snapshotP == NULL) {
+        return;
+    }
+    munmap((*snapshotP)->base, (*snapshotP)->size);
+    free(*snapshotP);
+    *snapshotP = NULL;
+}
+
+const SnapshotEntry* _snapshotFind(Snapshot* snapshot, char* key, uint32_t keyLen) {
+    const SnapshotHeader* header = snapshot->header;
+    uint64_t hash = HashWy(key, keyLen, header->seed);
+    uint32_t bucket = hash & (header->bucketCount - 1);
+    uint64_t start = snapshot->bucketStarts[bucket];
+    uint64_t end = snapshot->bucketStarts[bucket + 1];
+    if (start > end || end > header->entryCount) {
+        return NULL;
+    }
+    uint64_t i;
+    for (i = start; i < end; i++) {
+        const SnapshotEntry* entry = &snapshot->entries[i];
+        if (entry->hash != hash || entry->keyLen != keyLen) {
+            continue;
+        }
+        if (entry->keyOffset > header->dataSize
+            || (uint64_t)entry->keyLen + entry->valueLen + 2 > header->dataSize - entry->keyOffset) {
+            return NULL;
+        }
+        if (memcmp(snapshot->data + entry->keyOffset, key, keyLen) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+bool SnapshotGetView(Snapshot* snapshot, char* key, ValueView* view) {
+    if (snapshot == NULL || key == NULL || view == NULL) {
+        LOG("error: bad values provided");
+        return false;
+    }
+    const SnapshotEntry* entry = _snapshotFind(snapshot, key, strlen(key));
+    if (entry == NULL) {
+        return false;
+    }
+    view->data = snapshot->data + entry->keyOffset + entry->keyLen + 1;
+    view->len = entry->valueLen;
+    return true;
+}
+
+char* SnapshotGet(Snapshot* snapshot, char* key) {
+    ValueView view;
+    if (!SnapshotGetView(snapshot, key, &view)) {
+        return NULL;
+    }
+    char* value = malloc(view.len + 1);
+    if (value == NULL) {
+        return NULL;
+    }
+    memcpy(value, view.data, view.len + 1);
+    return value;
+}
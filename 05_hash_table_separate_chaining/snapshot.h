@@ -0,0 +1,59 @@
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "hash_table.h"
+
+#define SNAPSHOT_MAGIC "HTSNAP\0\0"
+#define SNAPSHOT_VERSION 1
+
+// file layout, every section starts at an 8 byte aligned offset
+// and all offsets are relative to the start of the file:
+//
+//   SnapshotHeader
+//   uint64_t bucketStarts[bucketCount + 1]   entries of bucket b are
+//                                            entries[bucketStarts[b] .. bucketStarts[b + 1])
+//   SnapshotEntry entries[entryCount]
+//   char data[dataSize]                      key\0value\0 for every entry
+//
+// the hashes are always HashWy with the seed stored in the header,
+// whatever hash function the saved table was using. Integers are
+// stored in the byte order of the machine that wrote the file
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t bucketCount;
+    uint64_t entryCount;
+    uint64_t seed;
+    uint64_t entriesOffset;
+    uint64_t dataOffset;
+    uint64_t dataSize;
+} SnapshotHeader;
+
+typedef struct {
+    uint64_t hash;
+    uint64_t keyOffset;
+    uint32_t keyLen;
+    uint32_t valueLen;
+} SnapshotEntry;
+
+// a read only table answering lookups straight from the mapped file
+typedef struct {
+    void* base;
+    size_t size;
+    const SnapshotHeader* header;
+    const uint64_t* bucketStarts;
+    const SnapshotEntry* entries;
+    const char* data;
+} Snapshot;
+
+bool SaveSnapshot(HashTable* hashTable, const char* path);
+Snapshot* OpenSnapshot(const char* path);
+void CloseSnapshot(Snapshot** snapshotP);
+// views point into the mapping and stay valid until CloseSnapshot
+bool SnapshotGetView(Snapshot* snapshot, char* key, ValueView* view);
+char* SnapshotGet(Snapshot* snapshot, char* key);
+
+unsigned int _snapshotCollectNodes(HashTable* hashTable, Node** nodes);
+bool _snapshotValidate(const Snapshot* snapshot);
+const SnapshotEntry* _snapshotFind(Snapshot* snapshot, char* key, uint32_t keyLen);
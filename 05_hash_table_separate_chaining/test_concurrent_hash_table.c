@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include "concurrent_hash_table.h"
+
+#define WRITERS 4
+#define READERS 4
+#define KEYS_PER_WRITER 20000
+
+typedef struct {
+    ConcurrentHashTable* table;
+    int id;
+    _Atomic bool* done;
+} WorkerArgs;
+
+void _testConcurrentStoreGetAndRemove() {
+    char* keys[] = { "key1","key2","key3","key4","key5","key6" };
+    ConcurrentHashTable* table = CreateConcurrentHashTable(5);
+    int i;
+    for (i = 0; i < 6; i++) {
+        assert(ConcurrentStore(table, keys[i], keys[i]) == true);
+    }
+    char buffer[64];
+    size_t valueLen;
+    for (i = 0; i < 6; i++) {
+        assert(ConcurrentGetInto(table, keys[i], buffer, sizeof(buffer), &valueLen) == true);
+        assert(strcmp(buffer, keys[i]) == 0);
+        assert(valueLen == strlen(keys[i]));
+    }
+    for (i = 0; i < 6; i++) {
+        assert(ConcurrentStore(table, keys[i], "default") == true);
+    }
+    assert(atomic_load(&table->storedElements) == 6);
+    for (i = 0; i < 6; i++) {
+        assert(ConcurrentGetInto(table, keys[i], buffer, sizeof(buffer), &valueLen) == true);
+        assert(strcmp(buffer, "default") == 0);
+    }
+    assert(ConcurrentGetInto(table, "missingKey", buffer, sizeof(buffer), &valueLen) == false);
+    assert(ConcurrentRemove(table, keys[1]) == true);
+    assert(ConcurrentRemove(table, keys[1]) == false);
+    assert(ConcurrentGetInto(table, keys[1], buffer, sizeof(buffer), &valueLen) == false);
+    assert(atomic_load(&table->storedElements) == 5);
+    DestroyConcurrentHashTable(&table);
+    assert(table == NULL);
+    printf("Testing concurrent hash table store, get and remove: PASS\n");
+}
+
+void* _writer(void* arg) {
+    WorkerArgs* args = arg;
+    char key[64];
+    int i;
+    for (i = 0; i < KEYS_PER_WRITER; i++) {
+        snprintf(key, sizeof(key), "writer_%d_key_%d", args->id, i);
+        assert(ConcurrentStore(args->table, key, key) == true);
+        // every key is overwritten once and every tenth one removed, so
+        // readers race with updates, removals and resizes
+        assert(ConcurrentStore(args->table, key, key) == true);
+        if (i % 10 == 0) {
+            assert(ConcurrentRemove(args->table, key) == true);
+        }
+    }
+    return NULL;
+}
+
+void* _reader(void* arg) {
+    WorkerArgs* args = arg;
+    char key[64];
+    char buffer[64];
+    unsigned int i = args->id;
+    while (!atomic_load(args->done)) {
+        snprintf(key, sizeof(key), "writer_%u_key_%u", i % WRITERS, (i * 7919) % KEYS_PER_WRITER);
+        size_t valueLen;
+        if (ConcurrentGetInto(args->table, key, buffer, sizeof(buffer), &valueLen)) {
+            assert(strcmp(buffer, key) == 0);
+            assert(valueLen == strlen(key));
+        }
+        i++;
+    }
+    return NULL;
+}
+
+void _testConcurrentWritersAndReaders() {
+    ConcurrentHashTable* table = CreateConcurrentHashTable(16);
+    unsigned int initialCapacity = atomic_load(&table->buckets)->capacity;
+    _Atomic bool done = false;
+    pthread_t writers[WRITERS], readers[READERS];
+    WorkerArgs writerArgs[WRITERS], readerArgs[READERS];
+    int i;
+    for (i = 0; i < READERS; i++) {
+        readerArgs[i] = (WorkerArgs){ table, i, &done };
+        pthread_create(&readers[i], NULL, _reader, &readerArgs[i]);
+    }
+    for (i = 0; i < WRITERS; i++) {
+        writerArgs[i] = (WorkerArgs){ table, i, &done };
+        pthread_create(&writers[i], NULL, _writer, &writerArgs[i]);
+    }
+    for (i = 0; i < WRITERS; i++) {
+        pthread_join(writers[i], NULL);
+    }
+    atomic_store(&done, true);
+    for (i = 0; i < READERS; i++) {
+        pthread_join(readers[i], NULL);
+    }
+
+    ConcurrentBuckets* buckets = atomic_load(&table->buckets);
+    // the writers must have grown the table while the readers were reading
+    assert(buckets->capacity > initialCapacity);
+    assert(atomic_load(&table->storedElements) == WRITERS * (KEYS_PER_WRITER - KEYS_PER_WRITER / 10));
+    char key[64];
+    char buffer[64];
+    int w;
+    for (w = 0; w < WRITERS; w++) {
+        for (i = 0; i < KEYS_PER_WRITER; i++) {
+            snprintf(key, sizeof(key), "writer_%d_key_%d", w, i);
+            bool found = ConcurrentGetInto(table, key, buffer, sizeof(buffer), NULL);
+            assert(found == (i % 10 != 0));
+        }
+    }
+    DestroyConcurrentHashTable(&table);
+    printf("Testing concurrent writers and readers: PASS\n");
+}
+
+typedef struct {
+    RetiredItem retired;
+    bool* released;
+} TrackedItem;
+
+void _releaseTracked(RetiredItem* item) {
+    TrackedItem* tracked = RETIRED_ENTRY(item, TrackedItem, retired);
+    *tracked->released = true;
+}
+
+void _testEpochReclamation() {
+    EpochDomain* domain = malloc(sizeof(EpochDomain));
+    assert(InitEpochDomain(domain) == true);
+    TrackedItem items[4 * EPOCH_ADVANCE_EVERY];
+    bool released[4 * EPOCH_ADVANCE_EVERY] = { false };
+    int i;
+    for (i = 0; i < 4 * EPOCH_ADVANCE_EVERY; i++) {
+        items[i].released = &released[i];
+    }
+
+    // while a reader is inside, the epoch moves at most once, which is not
+    // enough to release anything retired after it entered
+    int slot = EpochEnter(domain);
+    for (i = 0; i < 2 * EPOCH_ADVANCE_EVERY; i++) {
+        EpochRetire(domain, &items[i].retired, _releaseTracked);
+    }
+    for (i = 0; i < 2 * EPOCH_ADVANCE_EVERY; i++) {
+        assert(released[i] == false);
+    }
+    EpochExit(domain, slot);
+
+    // once it left, later retires move the epoch on and release the old ones
+    for (i = 2 * EPOCH_ADVANCE_EVERY; i < 4 * EPOCH_ADVANCE_EVERY; i++) {
+        EpochRetire(domain, &items[i].retired, _releaseTracked);
+    }
+    assert(released[0] == true);
+    DestroyEpochDomain(domain);
+    for (i = 0; i < 4 * EPOCH_ADVANCE_EVERY; i++) {
+        assert(released[i] == true);
+    }
+    free(domain);
+    printf("Testing epoch reclamation waits for readers: PASS\n");
+}
+
+int main(void) {
+    _testEpochReclamation();
+    _testConcurrentStoreGetAndRemove();
+    _testConcurrentWritersAndReaders();
+    return 0;
+}
@@ -2,6 +2,7 @@
 #include <string.h>
 #include <assert.h>
 #include "hash_table.h"
+#include "log_capture.h"
 
 void _testNewNode() {
     char* s;
@@ -11,11 +12,12 @@ void _testNewNode() {
     for (i = 0; i < MAX_KEY_LEN + 20; i++) {
         badString[i] = *"!";
     }
+    badString[MAX_KEY_LEN + 20] = '\0';
 
     Node* newNode = CreateNode(goodString, goodString);
-    s = newNode->key;
+    s = NodeKey(newNode);
     assert(*s == *goodString);
-    s = newNode->value;
+    s = NodeValue(newNode);
     assert(*s == *goodString);
     free(newNode);
     printf("Testing with good string: PASS\n");
@@ -127,13 +129,13 @@ void _testGetNodeValue() {
 
 void _testCreateHashTable() {
     HashTable* hashTable = CreateHashTable(3);
-    assert(hashTable->capacity == 10);
+    assert(hashTable->capacity == 16);
     free(hashTable->collection);
     free(hashTable);
     hashTable = CreateHashTable(15);
-    assert(hashTable->capacity == 15);
+    assert(hashTable->capacity == 16);
     unsigned int i;
-    for (i = 0; i < 15; i++) {
+    for (i = 0; i < 16; i++) {
         assert(hashTable->collection[i] == NULL);
 
     }
@@ -143,32 +145,123 @@ void _testCreateHashTable() {
 
 void _testCreateHashConsistency() {
     char* string = "hey, how are you";
-    int i, j;
-    for (j = 10; j < 1000; j++) {
-        unsigned int hash = _computeHash(string, j);
-        for (i = 0; i < 100; i++) {
-            assert(hash == _computeHash(string, j));
+    HashFunction hashFunctions[] = { HashPolynomial, HashFnv1a, HashWy };
+    int i, j, f;
+    for (f = 0; f < 3; f++) {
+        for (j = 16; j <= 1024; j *= 2) {
+            HashTable* hashTable = CreateHashTableWithHash(j, hashFunctions[f], RandomSeed());
+            uint64_t hash = _computeHash(hashTable, string);
+            for (i = 0; i < 100; i++) {
+                assert(hash == _computeHash(hashTable, string));
+            }
+            assert(_bucketIndex(hash, hashTable->capacity) < hashTable->capacity);
+            DestroyHashTable(&hashTable);
         }
     }
 }
 
+void _testHashFunctions() {
+    HashFunction hashFunctions[] = { HashPolynomial, HashFnv1a, HashWy };
+    char buffer[128];
+    char shifted[128 + 8];
+    int f;
+    size_t len, offset;
+    for (len = 0; len < sizeof(buffer); len++) {
+        buffer[len] = 'a' + len % 26;
+    }
+
+    printf("Testing hashes only depend on the key bytes\n");
+    for (f = 0; f < 3; f++) {
+        for (len = 0; len <= sizeof(buffer); len++) {
+            uint64_t expected = hashFunctions[f](buffer, len, 42);
+            for (offset = 1; offset < 8; offset++) {
+                memcpy(shifted + offset, buffer, len);
+                assert(hashFunctions[f](shifted + offset, len, 42) == expected);
+            }
+        }
+    }
+
+    printf("Testing seeds change the hashes\n");
+    for (f = 0; f < 3; f++) {
+        assert(hashFunctions[f](buffer, 20, 1) != hashFunctions[f](buffer, 20, 2));
+    }
+    HashTable* first = CreateHashTable(16);
+    HashTable* second = CreateHashTable(16);
+    assert(first->seed != second->seed);
+    DestroyHashTable(&first);
+    DestroyHashTable(&second);
+
+    printf("Testing HashWy looks at every byte\n");
+    for (len = 1; len <= sizeof(buffer); len++) {
+        uint64_t before = HashWy(buffer, len, 7);
+        buffer[len - 1] ^= 1;
+        assert(HashWy(buffer, len, 7) != before);
+        buffer[len - 1] ^= 1;
+        buffer[0] ^= 1;
+        assert(HashWy(buffer, len, 7) != before);
+        buffer[0] ^= 1;
+    }
+}
+
 void _testResizing() {
     char input[256];
     int i, INITIAL_CAP;
     INITIAL_CAP = 5;
     HashTable* hashTable = CreateHashTable(INITIAL_CAP);
-    assert(hashTable->capacity == INITIAL_CAP);
+    assert(hashTable->capacity == _roundCapacity(INITIAL_CAP));
     for (i = 0; i < 50; i++) {
         sprintf(input, "string_%d", i);
         bool success = Store(&hashTable, input, input);
         assert(success == true);
     }
-    assert(hashTable->capacity > INITIAL_CAP);
-    for (i = 0; i < hashTable->capacity; i++) {
-        ClearList(&hashTable->collection[i]);
+    assert(hashTable->capacity > _roundCapacity(INITIAL_CAP));
+    DestroyHashTable(&hashTable);
+    assert(hashTable == NULL);
+}
+
+void _testIncrementalRehash() {
+    char input[256];
+    int i, total = 200;
+    HashTable* hashTable = CreateHashTable(10);
+    Node* firstNode = NULL;
+    printf("Testing lookups while rehashing\n");
+    for (i = 0; i < total; i++) {
+        sprintf(input, "string_%d", i);
+        assert(Store(&hashTable, input, input) == true);
+        if (i == 0) {
+            firstNode = *_findLink(hashTable, input, _computeHash(hashTable, input));
+        }
+        if (_isRehashing(hashTable)) {
+            int j;
+            for (j = 0; j <= i; j++) {
+                sprintf(input, "string_%d", j);
+                ValueView view;
+                assert(GetView(hashTable, input, &view) == true);
+                assert(strcmp(view.data, input) == 0);
+            }
+        }
     }
-    free(hashTable->collection);
-    free(hashTable);
+    assert(hashTable->storedElements == total);
+
+    printf("Testing updates and removals while rehashing\n");
+    if (!_isRehashing(hashTable)) {
+        assert(_resize(hashTable) == true);
+    }
+    assert(_isRehashing(hashTable) == true);
+    assert(Store(&hashTable, "string_1", "updated") == true);
+    assert(Remove(hashTable, "string_2") == true);
+    assert(Remove(hashTable, "string_2") == false);
+    assert(hashTable->storedElements == total - 1);
+
+    printf("Testing nodes are reused by the migration\n");
+    _rehashStep(hashTable, hashTable->oldCapacity);
+    assert(_isRehashing(hashTable) == false);
+    assert(*_findLink(hashTable, "string_0", _computeHash(hashTable, "string_0")) == firstNode);
+    char* value = Get(hashTable, "string_1");
+    assert(strcmp(value, "updated") == 0);
+    free(value);
+    assert(Get(hashTable, "string_2") == NULL);
+    DestroyHashTable(&hashTable);
 }
 
 void _testStoreGetAndRemove() {
@@ -207,6 +300,339 @@ void _testStoreGetAndRemove() {
 
 }
 
+void _testVariableLengthValues() {
+    size_t longLen = 100000;
+    char* longValue = malloc(longLen + 1);
+    memset(longValue, 'v', longLen);
+    longValue[longLen] = '\0';
+
+    Node* node = CreateNode("k", "short");
+    assert(node->keyLen == 1);
+    assert(node->valueLen == 5);
+    assert(NodeValue(node) == NodeKey(node) + 2);
+    assert(node->valueCapacity == 5);
+
+    printf("Testing value update that fits in place\n");
+    Node* before = node;
+    bool success = UpdateNodeValue(&node, "tiny");
+    assert(success == true);
+    assert(node == before);
+    assert(strcmp(NodeValue(node), "tiny") == 0);
+    assert(node->valueLen == 4);
+    assert(node->valueCapacity == 5);
+
+    printf("Testing value update that grows back within the node\n");
+    success = UpdateNodeValue(&node, "short");
+    assert(success == true);
+    assert(node == before);
+    assert(strcmp(NodeValue(node), "short") == 0);
+    assert(node->valueLen == 5);
+
+    printf("Testing value update that needs a bigger node\n");
+    Node* tail = CreateNode("tail", "tail");
+    node->next = tail;
+    success = UpdateNodeValue(&node, longValue);
+    assert(success == true);
+    assert(node->valueLen == longLen);
+    assert(strcmp(NodeValue(node), longValue) == 0);
+    assert(strcmp(NodeKey(node), "k") == 0);
+    assert(node->next == tail);
+    ClearList(&node);
+
+    printf("Testing long values through the hash table\n");
+    HashTable* hashTable = CreateHashTable(5);
+    success = Store(&hashTable, "long", "short");
+    assert(success == true);
+    success = Store(&hashTable, "long", longValue);
+    assert(success == true);
+    char* value = Get(hashTable, "long");
+    assert(value != NULL);
+    assert(strcmp(value, longValue) == 0);
+    free(value);
+    DestroyHashTable(&hashTable);
+    free(longValue);
+}
+
+void _testZeroCopyGet() {
+    HashTable* hashTable = CreateHashTable(5);
+    Store(&hashTable, "name", "monkey");
+    Store(&hashTable, "empty", "");
+
+    printf("Testing borrowed views\n");
+    ValueView view;
+    bool found = GetView(hashTable, "name", &view);
+    assert(found == true);
+    assert(view.len == 6);
+    assert(memcmp(view.data, "monkey", view.len) == 0);
+    assert(GetView(hashTable, "missing", &view) == false);
+
+    printf("Testing copies into caller buffers\n");
+    char buffer[16];
+    size_t valueLen = 0;
+    found = GetInto(hashTable, "name", buffer, sizeof(buffer), &valueLen);
+    assert(found == true);
+    assert(valueLen == 6);
+    assert(strcmp(buffer, "monkey") == 0);
+
+    char small[4];
+    found = GetInto(hashTable, "name", small, sizeof(small), &valueLen);
+    assert(found == true);
+    assert(valueLen == 6);
+    assert(strcmp(small, "mon") == 0);
+
+    found = GetInto(hashTable, "empty", buffer, sizeof(buffer), &valueLen);
+    assert(found == true);
+    assert(valueLen == 0);
+    assert(buffer[0] == '\0');
+    assert(GetInto(hashTable, "missing", buffer, sizeof(buffer), &valueLen) == false);
+
+    printf("Testing copies of empty values\n");
+    char* value = Get(hashTable, "empty");
+    assert(value != NULL);
+    assert(strcmp(value, "") == 0);
+    free(value);
+
+    DestroyHashTable(&hashTable);
+}
+
+unsigned long hashCalls = 0;
+
+uint64_t _countingHash(const char* key, size_t len, uint64_t seed) {
+    hashCalls++;
+    return HashWy(key, len, seed);
+}
+
+uint64_t _collidingHash(const char* key, size_t len, uint64_t seed) {
+    return len < 8 ? 1 : 2;
+}
+
+void _testCachedHashes() {
+    char input[256];
+    int i, total = 100;
+
+    printf("Testing nodes keep the hash of their key\n");
+    HashTable* hashTable = CreateHashTableWithHash(4, _countingHash, 99);
+    for (i = 0; i < total; i++) {
+        sprintf(input, "string_%d", i);
+        Store(&hashTable, input, input);
+        Node* node = *_findLink(hashTable, input, _computeHash(hashTable, input));
+        assert(node->hash == _computeHash(hashTable, input));
+    }
+    Store(&hashTable, "string_1", "a value that does not fit in place");
+    assert((*_findLink(hashTable, "string_1", _computeHash(hashTable, "string_1")))->hash == _computeHash(hashTable, "string_1"));
+
+    printf("Testing migrations do not hash keys again\n");
+    if (!_isRehashing(hashTable)) {
+        assert(_resize(hashTable) == true);
+    }
+    unsigned long callsBefore = hashCalls;
+    _rehashStep(hashTable, hashTable->oldCapacity);
+    assert(hashCalls == callsBefore);
+    DestroyHashTable(&hashTable);
+
+    printf("Testing equal hashes still compare keys\n");
+    hashTable = CreateHashTableWithHash(16, _collidingHash, 0);
+    char* keys[] = { "a", "b", "c", "long key 1", "long key 2" };
+    for (i = 0; i < 5; i++) {
+        Store(&hashTable, keys[i], keys[i]);
+    }
+    for (i = 0; i < 5; i++) {
+        ValueView view;
+        assert(GetView(hashTable, keys[i], &view) == true);
+        assert(strcmp(view.data, keys[i]) == 0);
+    }
+    ValueView missing;
+    assert(GetView(hashTable, "d", &missing) == false);
+    DestroyHashTable(&hashTable);
+}
+
+void _testNodesFromPool() {
+    Pool* pool = CreatePool(sizeof(Node) + 32, 16);
+    HashTable* hashTable = CreateHashTableWithPool(16, pool);
+    char input[64];
+    int i;
+
+    printf("Testing small nodes come from the pool\n");
+    for (i = 0; i < 100; i++) {
+        sprintf(input, "key_%d", i);
+        assert(Store(&hashTable, input, "small") == true);
+    }
+    assert(hashTable->heapNodes == 0);
+    Node* node = *_findLink(hashTable, "key_1", _computeHash(hashTable, "key_1"));
+    assert(node->pooled == true);
+
+    printf("Testing big nodes fall back to malloc\n");
+    assert(Store(&hashTable, "key_1", "a value that is far too long to fit in a pooled node") == true);
+    assert(hashTable->heapNodes == 1);
+    node = *_findLink(hashTable, "key_1", _computeHash(hashTable, "key_1"));
+    assert(node->pooled == false);
+    assert(Remove(hashTable, "key_1") == true);
+    assert(hashTable->heapNodes == 0);
+
+    printf("Testing removed pooled nodes are recycled\n");
+    assert(Remove(hashTable, "key_2") == true);
+    void* recycled = pool->freeList;
+    assert(recycled != NULL);
+    assert(Store(&hashTable, "key_2", "small") == true);
+    assert(*_findLink(hashTable, "key_2", _computeHash(hashTable, "key_2")) == recycled);
+
+    for (i = 0; i < 100; i++) {
+        sprintf(input, "key_%d", i);
+        ValueView view;
+        assert(GetView(hashTable, input, &view) == (i != 1));
+    }
+    assert(Store(&hashTable, "big", "a value that is far too long to fit in a pooled node") == true);
+    DestroyHashTable(&hashTable);
+    PoolReset(pool);
+    DestroyPool(&pool);
+}
+
+Node** _nonEmptyBucket(HashTable* hashTable, unsigned int skip) {
+    unsigned int i;
+    for (i = 0; i < hashTable->capacity; i++) {
+        if (hashTable->collection[i] != NULL && skip-- == 0) {
+            return &hashTable->collection[i];
+        }
+    }
+    return NULL;
+}
+
+void _testListFunctionsOnPooledNodes() {
+    Pool* pool = CreatePool(sizeof(Node) + 32, 16);
+    HashTable* hashTable = CreateHashTableWithPool(16, pool);
+    char input[64];
+    int i;
+    for (i = 0; i < 100; i++) {
+        sprintf(input, "key_%d", i);
+        assert(Store(&hashTable, input, "small") == true);
+    }
+    _rehashStep(hashTable, hashTable->oldCapacity);
+
+    printf("Testing pooled nodes only grow through their table\n");
+    Node** bucket = _nonEmptyBucket(hashTable, 0);
+    Node* node = *bucket;
+    assert(node->pooled == true);
+    assert(UpdateNodeValue(bucket, "a value that is far too long to fit in a pooled node") == false);
+    assert(*bucket == node);
+    assert(strcmp(NodeValue(node), "small") == 0);
+    assert(UpdateNodeValue(bucket, "fits") == true);
+    assert(*bucket == node && strcmp(NodeValue(node), "fits") == 0);
+
+    printf("Testing list functions leave pooled nodes to the pool\n");
+    char key[64];
+    strcpy(key, NodeKey(node));
+    assert(RemoveNode(bucket, key) == true);
+    assert(FindNode(*bucket, key) == NULL);
+    bucket = _nonEmptyBucket(hashTable, 1);
+    unsigned int chained = 0;
+    for (node = *bucket; node != NULL; node = node->next) {
+        chained++;
+    }
+    assert(ClearList(bucket) == chained);
+    assert(*bucket == NULL);
+
+    DestroyHashTable(&hashTable);
+    PoolReset(pool);
+    DestroyPool(&pool);
+}
+
+void _testBatchStoreAndGet() {
+    unsigned int count = 1000;
+    char** keys = malloc(count * sizeof(char*));
+    char** values = malloc(count * sizeof(char*));
+    ValueView* views = malloc((count + 1) * sizeof(ValueView));
+    unsigned int i;
+    for (i = 0; i < count; i++) {
+        keys[i] = malloc(32);
+        values[i] = malloc(32);
+        sprintf(keys[i], "batch_key_%u", i);
+        sprintf(values[i], "batch_value_%u", i);
+    }
+
+    printf("Testing batched stores across resizes\n");
+    HashTable* hashTable = CreateHashTable(4);
+    assert(StoreMany(&hashTable, keys, values, count) == true);
+    assert(hashTable->storedElements == count);
+
+    printf("Testing batched lookups\n");
+    char* missing = keys[count - 1];
+    keys[count - 1] = "not there";
+    unsigned int found = GetMany(hashTable, keys, count, views);
+    assert(found == count - 1);
+    for (i = 0; i < count - 1; i++) {
+        assert(views[i].data != NULL);
+        assert(strcmp(views[i].data, values[i]) == 0);
+        assert(views[i].len == strlen(values[i]));
+    }
+    assert(views[count - 1].data == NULL);
+    keys[count - 1] = missing;
+
+    printf("Testing batched lookups with a NULL key\n");
+    char* replaced = keys[5];
+    keys[5] = NULL;
+    assert(GetMany(hashTable, keys, count, views) == count - 1);
+    assert(hashTable->lastStatus == HASH_TABLE_BAD_ARGUMENT);
+    assert(views[5].data == NULL && views[5].len == 0);
+    assert(strcmp(views[6].data, values[6]) == 0);
+    keys[5] = replaced;
+
+    printf("Testing batched updates\n");
+    for (i = 0; i < count; i++) {
+        values[i][0] = 'B';
+    }
+    assert(StoreMany(&hashTable, keys, values, count) == true);
+    assert(hashTable->storedElements == count);
+    assert(GetMany(hashTable, keys, count, views) == count);
+    for (i = 0; i < count; i++) {
+        assert(views[i].data[0] == 'B');
+    }
+
+    DestroyHashTable(&hashTable);
+    for (i = 0; i < count; i++) {
+        free(keys[i]);
+        free(values[i]);
+    }
+    free(keys);
+    free(values);
+    free(views);
+}
+
+void _testStatusAndLogHook() {
+    printf("Testing statuses of the last operation\n");
+    HashTable* hashTable = CreateHashTable(16);
+    assert(hashTable->lastStatus == HASH_TABLE_OK);
+    assert(Get(hashTable, "missing") == NULL);
+    assert(hashTable->lastStatus == HASH_TABLE_NOT_FOUND);
+    assert(Store(&hashTable, "key", "value") == true);
+    assert(hashTable->lastStatus == HASH_TABLE_OK);
+    assert(Store(&hashTable, "key", NULL) == false);
+    assert(hashTable->lastStatus == HASH_TABLE_BAD_ARGUMENT);
+
+    char* longKey = malloc(MAX_KEY_LEN + 2);
+    memset(longKey, 'k', MAX_KEY_LEN + 1);
+    longKey[MAX_KEY_LEN + 1] = '\0';
+    assert(Store(&hashTable, longKey, "value") == false);
+    assert(hashTable->lastStatus == HASH_TABLE_TOO_LONG);
+    free(longKey);
+
+    char* keys[] = { "key", "other" };
+    ValueView views[2];
+    assert(GetMany(hashTable, keys, 2, views) == 1);
+    assert(hashTable->lastStatus == HASH_TABLE_NOT_FOUND);
+    assert(Remove(hashTable, "key") == true);
+    assert(hashTable->lastStatus == HASH_TABLE_OK);
+    assert(Remove(hashTable, "key") == false);
+    assert(hashTable->lastStatus == HASH_TABLE_NOT_FOUND);
+    assert(strcmp(HashTableStatusString(HASH_TABLE_NOT_FOUND), "key not found") == 0);
+    DestroyHashTable(&hashTable);
+
+    printf("Testing the log hook\n");
+    SetLogHook(_captureMessage);
+    _logMessage("resized to %u buckets", 32u);
+    assert(strcmp(lastMessage, "resized to 32 buckets") == 0);
+    SetLogHook(NULL);
+}
+
 int main(void) {
     _testNewNode();
     _testClearList();
@@ -214,7 +640,16 @@ int main(void) {
     _testGetNodeValue();
     _testCreateHashTable();
     _testCreateHashConsistency();
+    _testHashFunctions();
     _testResizing();
+    _testIncrementalRehash();
+    _testCachedHashes();
+    _testNodesFromPool();
+    _testListFunctionsOnPooledNodes();
+    _testBatchStoreAndGet();
     _testStoreGetAndRemove();
+    _testVariableLengthValues();
+    _testZeroCopyGet();
+    _testStatusAndLogHook();
     return 0;
 }
\ No newline at end of file
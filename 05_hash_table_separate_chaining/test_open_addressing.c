@@ -0,0 +1,146 @@
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "open_addressing.h"
+
+void _testCreateOpenHashTable() {
+    OpenHashTable* table = CreateOpenHashTable(3);
+    assert(table->capacity == OPEN_INITIAL_CAPACITY);
+    DestroyOpenHashTable(&table);
+    assert(table == NULL);
+
+    table = CreateOpenHashTable(100);
+    assert(table->capacity == 128);
+    unsigned int i;
+    for (i = 0; i < table->capacity; i++) {
+        assert(table->meta[i] == 0);
+    }
+    DestroyOpenHashTable(&table);
+    printf("Testing open hash table creation: PASS\n");
+}
+
+void _testOpenStoreGetAndRemove() {
+    char* keys[] = { "key1","key2","key3","key4","key5","key6" };
+    OpenHashTable* table = CreateOpenHashTable(5);
+    int i;
+    for (i = 0; i < 6; i++) {
+        bool success = OpenStore(table, keys[i], keys[i]);
+        assert(success == true);
+    }
+    for (i = 0; i < 6; i++) {
+        char* value = OpenGet(table, keys[i]);
+        assert(strcmp(value, keys[i]) == 0);
+        free(value);
+    }
+    char* defaultValue = "a longer default value";
+    for (i = 0; i < 6; i++) {
+        bool success = OpenStore(table, keys[i], defaultValue);
+        assert(success == true);
+    }
+    assert(table->storedElements == 6);
+    for (i = 0; i < 6; i++) {
+        char* value = OpenGet(table, keys[i]);
+        assert(strcmp(value, defaultValue) == 0);
+        free(value);
+    }
+    assert(OpenGet(table, "missingKey") == NULL);
+    bool success = OpenRemove(table, keys[1]);
+    assert(success == true);
+    assert(OpenGet(table, keys[1]) == NULL);
+    success = OpenRemove(table, keys[1]);
+    assert(success == false);
+    assert(table->storedElements == 5);
+    DestroyOpenHashTable(&table);
+    printf("Testing open hash table store, get and remove: PASS\n");
+}
+
+void _testOpenResizingAndBackwardShift() {
+    char input[256];
+    int i, total = 5000;
+    OpenHashTable* table = CreateOpenHashTable(4);
+    for (i = 0; i < total; i++) {
+        sprintf(input, "string_%d", i);
+        bool success = OpenStore(table, input, input);
+        assert(success == true);
+    }
+    assert(table->storedElements == total);
+    assert(table->storedElements <= table->capacity * OPEN_MAX_LOAD_FACTOR);
+
+    for (i = 0; i < total; i += 2) {
+        sprintf(input, "string_%d", i);
+        assert(OpenRemove(table, input) == true);
+    }
+    for (i = 0; i < total; i++) {
+        sprintf(input, "string_%d", i);
+        char* value = OpenGet(table, input);
+        if (i % 2 == 0) {
+            assert(value == NULL);
+            continue;
+        }
+        assert(value != NULL);
+        assert(strcmp(value, input) == 0);
+        free(value);
+    }
+
+    unsigned int mask = table->capacity - 1;
+    unsigned int position;
+    for (position = 0; position < table->capacity; position++) {
+        if (table->meta[position] == 0) continue;
+        unsigned int home = table->slots[position].hash & mask;
+        assert(((position - home) & mask) == (unsigned int)(table->meta[position] - 1));
+    }
+    DestroyOpenHashTable(&table);
+    printf("Testing open hash table resizing and backward shift deletion: PASS\n");
+}
+
+void _testOpenEntryData() {
+    OpenHashTable* table = CreateOpenHashTable(16);
+    assert(OpenStore(table, "key", "a long enough value") == true);
+    int64_t position = _openFind(table, "key", 3, _openComputeHash("key", 3));
+    assert(position >= 0);
+    uint32_t offset = table->slots[position].offset;
+    size_t dataLen = table->dataLen;
+
+    // a shorter value is written where the old one was
+    assert(OpenStore(table, "key", "short") == true);
+    assert(table->slots[position].offset == offset);
+    assert(table->slots[position].valueLen == 5);
+    assert(table->dataLen == dataLen);
+    char* value = OpenGet(table, "key");
+    assert(strcmp(value, "short") == 0);
+    free(value);
+
+    // replaced and removed entries are dropped when data is repacked,
+    // so churning through the same keys does not keep growing it
+    char input[64];
+    int i, round;
+    for (round = 0; round < 100; round++) {
+        for (i = 0; i < 50; i++) {
+            sprintf(input, "string_%d", i);
+            assert(OpenStore(table, input, round % 2 == 0 ? "a value of some length" : "a value that is longer than that") == true);
+        }
+        sprintf(input, "string_%d", round % 50);
+        assert(OpenRemove(table, input) == true);
+    }
+    assert(table->dataCapacity <= 16 * 1024);
+    for (i = 0; i < 50; i++) {
+        sprintf(input, "string_%d", i);
+        value = OpenGet(table, input);
+        if (i == 99 % 50) {
+            assert(value == NULL);
+            continue;
+        }
+        assert(strcmp(value, "a value that is longer than that") == 0);
+        free(value);
+    }
+    DestroyOpenHashTable(&table);
+    printf("Testing open hash table entry data: PASS\n");
+}
+
+int main(void) {
+    _testCreateOpenHashTable();
+    _testOpenStoreGetAndRemove();
+    _testOpenResizingAndBackwardShift();
+    _testOpenEntryData();
+    return 0;
+}
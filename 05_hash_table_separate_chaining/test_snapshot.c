@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include "snapshot.h"
+
+#define SNAPSHOT_PATH "test_snapshot.bin"
+
+void _testSaveAndOpenSnapshot() {
+    char key[64], value[64];
+    int i, total = 0;
+    HashTable* hashTable = CreateHashTable(4);
+    assert(Store(&hashTable, "empty", "") == true);
+    // saving in the middle of an incremental rehash must not lose entries
+    while (total < 2000 || !_isRehashing(hashTable)) {
+        sprintf(key, "key_%d", total);
+        sprintf(value, "value_%d", total * 7);
+        assert(Store(&hashTable, key, value) == true);
+        total++;
+    }
+    assert(SaveSnapshot(hashTable, SNAPSHOT_PATH) == true);
+    DestroyHashTable(&hashTable);
+
+    Snapshot* snapshot = OpenSnapshot(SNAPSHOT_PATH);
+    assert(snapshot != NULL);
+    assert(snapshot->header->entryCount == (uint64_t)total + 1);
+    for (i = 0; i < total; i++) {
+        sprintf(key, "key_%d", i);
+        sprintf(value, "value_%d", i * 7);
+        ValueView view;
+        assert(SnapshotGetView(snapshot, key, &view) == true);
+        assert(view.len == strlen(value));
+        assert(memcmp(view.data, value, view.len) == 0);
+        assert(view.data[view.len] == '\0');
+        // views point straight into the mapping
+        assert(view.data > (char*)snapshot->base && view.data < (char*)snapshot->base + snapshot->size);
+    }
+    char* copy = SnapshotGet(snapshot, "empty");
+    assert(copy != NULL && strcmp(copy, "") == 0);
+    free(copy);
+
+    ValueView view;
+    assert(SnapshotGetView(snapshot, "missing", &view) == false);
+    assert(SnapshotGet(snapshot, "key_") == NULL);
+    CloseSnapshot(&snapshot);
+    assert(snapshot == NULL);
+    unlink(SNAPSHOT_PATH);
+    printf("Testing saving and mapping a snapshot: PASS\n");
+}
+
+void _testSnapshotWithOtherHashFunction() {
+    HashTable* hashTable = CreateHashTableWithHash(16, HashFnv1a, 42);
+    assert(Store(&hashTable, "alpha", "1") == true);
+    assert(Store(&hashTable, "beta", "2") == true);
+    assert(SaveSnapshot(hashTable, SNAPSHOT_PATH) == true);
+    DestroyHashTable(&hashTable);
+
+    Snapshot* snapshot = OpenSnapshot(SNAPSHOT_PATH);
+    assert(snapshot != NULL);
+    char* value = SnapshotGet(snapshot, "beta");
+    assert(strcmp(value, "2") == 0);
+    free(value);
+    CloseSnapshot(&snapshot);
+    unlink(SNAPSHOT_PATH);
+    printf("Testing snapshots of tables with another hash function: PASS\n");
+}
+
+void _testRejectBadSnapshots() {
+    assert(OpenSnapshot("does_not_exist.bin") == NULL);
+
+    FILE* file = fopen(SNAPSHOT_PATH, "wb");
+    fputs("definitely not a snapshot, just some text that is long enough", file);
+    fclose(file);
+    assert(OpenSnapshot(SNAPSHOT_PATH) == NULL);
+
+    // a snapshot cut short must be rejected instead of read past its end
+    HashTable* hashTable = CreateHashTable(16);
+    assert(Store(&hashTable, "key", "value") == true);
+    assert(SaveSnapshot(hashTable, SNAPSHOT_PATH) == true);
+    DestroyHashTable(&hashTable);
+    assert(truncate(SNAPSHOT_PATH, sizeof(SnapshotHeader) + 16) == 0);
+    assert(OpenSnapshot(SNAPSHOT_PATH) == NULL);
+    unlink(SNAPSHOT_PATH);
+    printf("Testing bad snapshots are rejected: PASS\n");
+}
+
+int main(void) {
+    _testSaveAndOpenSnapshot();
+    _testSnapshotWithOtherHashFunction();
+    _testRejectBadSnapshots();
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include "pool.h"
+
+#define OBJECTS 1000000
+#define CHURN_ROUNDS 20
+#define OBJECT_SIZE 48
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+uint32_t _nextRandom(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+// fill, then repeatedly free and reallocate random objects, then tear everything down
+void _bench(void** objects, Pool* pool) {
+    uint32_t state = 2463534242u;
+    uint32_t i, round;
+
+    double start = _nowSeconds();
+    for (i = 0; i < OBJECTS; i++) {
+        objects[i] = pool ? PoolAlloc(pool) : malloc(OBJECT_SIZE);
+        *(uint32_t*)objects[i] = i;
+    }
+    double fill = _nowSeconds() - start;
+
+    start = _nowSeconds();
+    for (round = 0; round < CHURN_ROUNDS; round++) {
+        for (i = 0; i < OBJECTS / 10; i++) {
+            uint32_t victim = _nextRandom(&state) % OBJECTS;
+            if (pool) {
+                PoolFree(pool, objects[victim]);
+                objects[victim] = PoolAlloc(pool);
+            }
+            else {
+                free(objects[victim]);
+                objects[victim] = malloc(OBJECT_SIZE);
+            }
+            *(uint32_t*)objects[victim] = victim;
+        }
+    }
+    double churn = _nowSeconds() - start;
+
+    start = _nowSeconds();
+    if (pool) {
+        PoolReset(pool);
+    }
+    else {
+        for (i = 0; i < OBJECTS; i++) {
+            free(objects[i]);
+        }
+    }
+    double teardown = _nowSeconds() - start;
+
+    printf("%-8s fill %6.1f ns/object   churn %6.1f ns/op   teardown %10.0f us\n",
+        pool ? "pool" : "malloc",
+        fill * 1e9 / OBJECTS,
+        churn * 1e9 / (CHURN_ROUNDS * (OBJECTS / 10)),
+        teardown * 1e6);
+}
+
+int main(void) {
+    void** objects = malloc(OBJECTS * sizeof(void*));
+    Pool* pool = CreatePool(OBJECT_SIZE, 4096);
+    printf("%d objects of %d bytes\n", OBJECTS, OBJECT_SIZE);
+    _bench(objects, NULL);
+    _bench(objects, pool);
+    DestroyPool(&pool);
+    free(objects);
+    return 0;
+}
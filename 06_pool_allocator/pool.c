@@ -0,0 +1,100 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "pool.h"
+
+Pool* CreatePool(size_t objectSize, size_t objectsPerBlock) {
+    if (objectSize == 0 || objectsPerBlock == 0) {
+        return NULL;
+    }
+    Pool* pool = malloc(sizeof(Pool));
+    if (pool == NULL) {
+        return NULL;
+    }
+    size_t alignment = _Alignof(max_align_t);
+    if (objectSize < sizeof(PoolSlot)) {
+        objectSize = sizeof(PoolSlot);
+    }
+    pool->objectSize = (objectSize + alignment - 1) / alignment * alignment;
+    pool->objectsPerBlock = objectsPerBlock;
+    pool->firstBlock = NULL;
+    pool->currentBlock = NULL;
+    pool->cursor = NULL;
+    pool->blockEnd = NULL;
+    pool->freeList = NULL;
+    return pool;
+}
+
+void DestroyPool(Pool** poolP) {
+    if (poolP == NULL || *poolP == NULL) {
+        return;
+    }
+    Pool* pool = *poolP;
+    PoolBlock* block = pool->firstBlock;
+    while (block != NULL) {
+        PoolBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    free(pool);
+    *poolP = NULL;
+}
+
+bool _poolNextBlock(Pool* pool) {
+    PoolBlock* block = pool->currentBlock == NULL ? pool->firstBlock : pool->currentBlock->next;
+    if (block == NULL) {
+        block = malloc(sizeof(PoolBlock) + pool->objectSize * pool->objectsPerBlock);
+        if (block == NULL) {
+            return false;
+        }
+        block->next = NULL;
+        if (pool->currentBlock == NULL) {
+            pool->firstBlock = block;
+        }
+        else {
+            pool->currentBlock->next = block;
+        }
+    }
+    pool->currentBlock = block;
+    pool->cursor = (char*)block->data;
+    pool->blockEnd = pool->cursor + pool->objectSize * pool->objectsPerBlock;
+    return true;
+}
+
+void* PoolAlloc(Pool* pool) {
+    if (pool == NULL) {
+        return NULL;
+    }
+    if (pool->freeList != NULL) {
+        PoolSlot* slot = pool->freeList;
+        pool->freeList = slot->next;
+        return slot;
+    }
+    if (pool->cursor == pool->blockEnd && !_poolNextBlock(pool)) {
+        return NULL;
+    }
+    void* object = pool->cursor;
+    pool->cursor += pool->objectSize;
+    return object;
+}
+
+void PoolFree(Pool* pool, void* object) {
+    if (pool == NULL || object == NULL) {
+        return;
+    }
+    PoolSlot* slot = object;
+    slot->next = pool->freeList;
+    pool->freeList = slot;
+}
+
+void PoolReset(Pool* pool) {
+    if (pool == NULL) {
+        return;
+    }
+    // blocks are kept and refilled from the start
+    pool->currentBlock = NULL;
+    pool->cursor = NULL;
+    pool->blockEnd = NULL;
+    pool->freeList = NULL;
+}
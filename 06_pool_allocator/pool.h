@@ -0,0 +1,34 @@
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef struct PoolBlock_T {
+    struct PoolBlock_T* next;
+    max_align_t data[];
+} PoolBlock;
+
+typedef struct PoolSlot_T {
+    struct PoolSlot_T* next;
+} PoolSlot;
+
+// hands out fixed size objects carved from big blocks, freed objects go
+// to a free list and PoolReset releases everything at once
+typedef struct {
+    size_t objectSize;
+    size_t objectsPerBlock;
+    PoolBlock* firstBlock;
+    PoolBlock* currentBlock;
+    char* cursor;
+    char* blockEnd;
+    PoolSlot* freeList;
+} Pool;
+
+Pool* CreatePool(size_t objectSize, size_t objectsPerBlock);
+void DestroyPool(Pool** poolP);
+void* PoolAlloc(Pool* pool);
+void PoolFree(Pool* pool, void* object);
+void PoolReset(Pool* pool);
+
+bool _poolNextBlock(Pool* pool);
@@ -0,0 +1,100 @@
+#include <stdint.h>
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include "pool.h"
+
+void _cleanup(Pool* pool) {
+    DestroyPool(&pool);
+    assert(pool == NULL);
+}
+
+void TestCreatePool() {
+    Pool* pool = CreatePool(1, 10);
+    assert(pool != NULL);
+    assert(pool->objectSize == _Alignof(max_align_t));
+    assert(pool->firstBlock == NULL);
+    _cleanup(pool);
+
+    pool = CreatePool(40, 10);
+    assert(pool->objectSize % _Alignof(max_align_t) == 0);
+    assert(pool->objectSize >= 40);
+    _cleanup(pool);
+
+    assert(CreatePool(0, 10) == NULL);
+    assert(CreatePool(10, 0) == NULL);
+}
+
+void _testAllocations(uint32_t objects) {
+    Pool* pool = CreatePool(sizeof(int64_t) * 3, 7);
+    int64_t** allocated = malloc(objects * sizeof(int64_t*));
+    uint32_t i;
+    for (i = 0; i < objects; i++) {
+        allocated[i] = PoolAlloc(pool);
+        assert(allocated[i] != NULL);
+        assert((uintptr_t)allocated[i] % _Alignof(max_align_t) == 0);
+        allocated[i][0] = i;
+        allocated[i][2] = -(int64_t)i;
+    }
+    for (i = 0; i < objects; i++) {
+        assert(allocated[i][0] == i);
+        assert(allocated[i][2] == -(int64_t)i);
+    }
+
+    // freed objects are handed out again before touching new memory
+    for (i = 0; i < objects; i += 2) {
+        PoolFree(pool, allocated[i]);
+    }
+    char* cursorBefore = pool->cursor;
+    for (i = 0; i < objects; i += 2) {
+        allocated[i] = PoolAlloc(pool);
+        allocated[i][0] = i;
+    }
+    assert(pool->cursor == cursorBefore);
+    for (i = 0; i < objects; i++) {
+        assert(allocated[i][0] == i);
+    }
+    free(allocated);
+    _cleanup(pool);
+}
+
+void TestAllocations() {
+    uint32_t testCases[4] = { 10,100,1000,10000 };
+    int i, len;
+    len = sizeof(testCases) / sizeof(testCases[0]);
+    for (i = 0; i < len; i++) {
+        _testAllocations(testCases[i]);
+    }
+}
+
+void TestReset() {
+    Pool* pool = CreatePool(32, 16);
+    int i;
+    void* first = PoolAlloc(pool);
+    for (i = 1; i < 100; i++) {
+        PoolAlloc(pool);
+    }
+    PoolBlock* firstBlock = pool->firstBlock;
+    int blocks = 0;
+    PoolBlock* block;
+    for (block = pool->firstBlock; block != NULL; block = block->next) blocks++;
+
+    PoolReset(pool);
+    assert(PoolAlloc(pool) == first);
+    for (i = 1; i < 100; i++) {
+        PoolAlloc(pool);
+    }
+    int blocksAfter = 0;
+    for (block = pool->firstBlock; block != NULL; block = block->next) blocksAfter++;
+    assert(pool->firstBlock == firstBlock);
+    assert(blocksAfter == blocks);
+    _cleanup(pool);
+}
+
+int main(void) {
+    TestCreatePool();
+    TestAllocations();
+    TestReset();
+    return 0;
+}
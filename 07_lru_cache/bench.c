@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "cache.h"
+
+#define KEY_SPACE 1000000
+#define TRACE_LENGTH 4000000
+#define KEY_LEN 16
+#define VALUE "a value of about thirty-two byte"
+#define SHARDS 16
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// key ranks drawn from a Zipf distribution: rank r is requested with a
+// probability proportional to 1 / r^skew, like the popularity of web pages
+uint32_t* _zipfTrace(double skew, unsigned int seed) {
+    double* cdf = malloc(KEY_SPACE * sizeof(double));
+    uint32_t* trace = malloc(TRACE_LENGTH * sizeof(uint32_t));
+    double total = 0;
+    uint32_t i;
+    for (i = 0; i < KEY_SPACE; i++) {
+        total += 1.0 / pow(i + 1, skew);
+        cdf[i] = total;
+    }
+    srand(seed);
+    for (i = 0; i < TRACE_LENGTH; i++) {
+        double target = (double)rand() / RAND_MAX * total;
+        uint32_t low = 0, high = KEY_SPACE - 1;
+        while (low < high) {
+            uint32_t middle = (low + high) / 2;
+            if (cdf[middle] < target) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        trace[i] = low;
+    }
+    free(cdf);
+    return trace;
+}
+
+char (*_makeKeys())[KEY_LEN] {
+    char (*keys)[KEY_LEN] = malloc(KEY_SPACE * sizeof(*keys));
+    uint32_t i;
+    for (i = 0; i < KEY_SPACE; i++) {
+        snprintf(keys[i], KEY_LEN, "key:%u", i);
+    }
+    return keys;
+}
+
+// every request reads the key and stores it on a miss, like a read-through cache
+void _benchCache(char (*keys)[KEY_LEN], uint32_t* trace, uint64_t maxEntries) {
+    Cache* cache = CreateCache(maxEntries, 0);
+    CacheView view;
+    uint32_t i;
+    double start = _nowSeconds();
+    for (i = 0; i < TRACE_LENGTH; i++) {
+        if (!CacheGet(cache, keys[trace[i]], &view)) {
+            CachePut(cache, keys[trace[i]], VALUE);
+        }
+    }
+    double elapsed = _nowSeconds() - start;
+    printf("  %8llu entries (%4.1f%% of keys)   hit rate %5.1f%%   %6.2f M requests/s\n",
+        (unsigned long long)maxEntries, 100.0 * maxEntries / KEY_SPACE,
+        100.0 * cache->hits / TRACE_LENGTH, TRACE_LENGTH / elapsed / 1e6);
+    DestroyCache(&cache);
+}
+
+typedef struct {
+    ShardedCache* cache;
+    char (*keys)[KEY_LEN];
+    uint32_t* trace;
+    uint32_t start;
+    uint32_t end;
+    uint64_t hits;
+    pthread_t thread;
+} Worker;
+
+void* _shardedWorker(void* arg) {
+    Worker* worker = arg;
+    char buffer[64];
+    size_t valueLen;
+    uint32_t i;
+    for (i = worker->start; i < worker->end; i++) {
+        const char* key = worker->keys[worker->trace[i]];
+        if (ShardedCacheGet(worker->cache, key, buffer, sizeof(buffer), &valueLen)) {
+            worker->hits++;
+        } else {
+            ShardedCachePut(worker->cache, key, VALUE);
+        }
+    }
+    return NULL;
+}
+
+void _benchSharded(char (*keys)[KEY_LEN], uint32_t* trace, uint64_t maxEntries, unsigned int threads) {
+    ShardedCache* cache = CreateShardedCache(SHARDS, maxEntries, 0);
+    Worker workers[64];
+    unsigned int i;
+    uint64_t hits = 0;
+    double start = _nowSeconds();
+    for (i = 0; i < threads; i++) {
+        workers[i].cache = cache;
+        workers[i].keys = keys;
+        workers[i].trace = trace;
+        workers[i].start = (uint64_t)TRACE_LENGTH * i / threads;
+        workers[i].end = (uint64_t)TRACE_LENGTH * (i + 1) / threads;
+        workers[i].hits = 0;
+        pthread_create(&workers[i].thread, NULL, _shardedWorker, &workers[i]);
+    }
+    for (i = 0; i < threads; i++) {
+        pthread_join(workers[i].thread, NULL);
+        hits += workers[i].hits;
+    }
+    double elapsed = _nowSeconds() - start;
+    printf("  %2u threads   hit rate %5.1f%%   %6.2f M requests/s\n", threads,
+        100.0 * hits / TRACE_LENGTH, TRACE_LENGTH / elapsed / 1e6);
+    DestroyShardedCache(&cache);
+}
+
+int main(void) {
+    char (*keys)[KEY_LEN] = _makeKeys();
+    double skews[] = { 0.7, 0.99 };
+    uint64_t sizes[] = { KEY_SPACE / 100, KEY_SPACE / 20, KEY_SPACE / 10, KEY_SPACE / 4 };
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int maxThreads = cores > 8 ? (cores < 64 ? cores : 64) : 8, threads;
+    int s, c;
+    for (s = 0; s < 2; s++) {
+        uint32_t* trace = _zipfTrace(skews[s], 42);
+        printf("Zipf skew %.2f, %d keys, %d requests\n", skews[s], KEY_SPACE, TRACE_LENGTH);
+        for (c = 0; c < 4; c++) {
+            _benchCache(keys, trace, sizes[c]);
+        }
+        printf(" sharded, %d shards, %d entries, %ld cores\n", SHARDS, KEY_SPACE / 10, cores);
+        for (threads = 1; threads <= maxThreads; threads *= 2) {
+            _benchSharded(keys, trace, KEY_SPACE / 10, threads);
+        }
+        free(trace);
+    }
+    free(keys);
+    return 0;
+}
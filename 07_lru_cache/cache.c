@@ -0,0 +1,327 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "cache.h"
+
+size_t CacheEntrySize(size_t keyLen, size_t valueLen) {
+    return sizeof(CacheEntry) + keyLen + valueLen + 2;
+}
+
+Cache* _createCacheWithSeed(uint64_t maxEntries, uint64_t maxBytes, uint64_t seed) {
+    Cache* cache = malloc(sizeof(Cache));
+    if (cache == NULL) {
+        return NULL;
+    }
+    cache->buckets = calloc(CACHE_INITIAL_BUCKETS, sizeof(CacheEntry*));
+    if (cache->buckets == NULL) {
+        free(cache);
+        return NULL;
+    }
+    cache->bucketCount = CACHE_INITIAL_BUCKETS;
+    cache->size = 0;
+    InitList(&cache->recency);
+    cache->maxEntries = maxEntries;
+    cache->maxBytes = maxBytes;
+    cache->bytes = 0;
+    cache->seed = seed;
+    cache->onEvict = NULL;
+    cache->evictContext = NULL;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+    return cache;
+}
+
+Cache* CreateCache(uint64_t maxEntries, uint64_t maxBytes) {
+    return _createCacheWithSeed(maxEntries, maxBytes, RandomSeed());
+}
+
+void DestroyCache(Cache** cacheP) {
+    if (cacheP == NULL || *cacheP == NULL) {
+        return;
+    }
+    Cache* cache = *cacheP;
+    ListLink* link;
+    while ((link = ListPopFront(&cache->recency)) != NULL) {
+        free(LIST_ENTRY(link, CacheEntry, recency));
+    }
+    free(cache->buckets);
+    free(cache);
+    *cacheP = NULL;
+}
+
+void SetEvictionCallback(Cache* cache, EvictionCallback onEvict, void* context) {
+    cache->onEvict = onEvict;
+    cache->evictContext = context;
+}
+
+// the link that points to the entry with this key, or to the NULL at
+// the end of its bucket when there is none
+CacheEntry** _cacheFindLink(Cache* cache, const char* key, size_t keyLen, uint64_t hash) {
+    CacheEntry** link = &cache->buckets[hash & (cache->bucketCount - 1)];
+    while (*link != NULL) {
+        CacheEntry* entry = *link;
+        if (entry->hash == hash && entry->keyLen == keyLen && memcmp(entry->data, key, keyLen) == 0) {
+            break;
+        }
+        link = &entry->hashNext;
+    }
+    return link;
+}
+
+// the entries keep their hash, so growing the index never hashes a key again
+bool _cacheGrowIndex(Cache* cache) {
+    uint32_t bucketCount = cache->bucketCount * 2;
+    CacheEntry** buckets = calloc(bucketCount, sizeof(CacheEntry*));
+    if (buckets == NULL) {
+        return false;
+    }
+    uint32_t i;
+    for (i = 0; i < cache->bucketCount; i++) {
+        CacheEntry* entry = cache->buckets[i];
+        while (entry != NULL) {
+            CacheEntry* next = entry->hashNext;
+            CacheEntry** bucket = &buckets[entry->hash & (bucketCount - 1)];
+            entry->hashNext = *bucket;
+            *bucket = entry;
+            entry = next;
+        }
+    }
+    free(cache->buckets);
+    cache->buckets = buckets;
+    cache->bucketCount = bucketCount;
+    return true;
+}
+
+void _cacheUnlinkEntry(Cache* cache, CacheEntry** link) {
+    CacheEntry* entry = *link;
+    *link = entry->hashNext;
+    ListUnlink(&cache->recency, &entry->recency);
+    cache->size--;
+    cache->bytes -= CacheEntrySize(entry->keyLen, entry->valueLen);
+    free(entry);
+}
+
+bool _cacheOverLimits(Cache* cache) {
+    return (cache->maxEntries > 0 && cache->size > cache->maxEntries)
+        || (cache->maxBytes > 0 && cache->bytes > cache->maxBytes);
+}
+
+// drops the least recently used entry
+void _cacheEvict(Cache* cache) {
+    CacheEntry* victim = LIST_ENTRY(ListBack(&cache->recency), CacheEntry, recency);
+    CacheEntry** link = &cache->buckets[victim->hash & (cache->bucketCount - 1)];
+    while (*link != victim) {
+        link = &(*link)->hashNext;
+    }
+    if (cache->onEvict != NULL) {
+        cache->onEvict(victim->data, victim->keyLen, victim->data + victim->keyLen + 1, victim->valueLen,
+            cache->evictContext);
+    }
+    cache->evictions++;
+    _cacheUnlinkEntry(cache, link);
+}
+
+bool _cachePutHashed(Cache* cache, const char* key, size_t keyLen, uint64_t hash, const char* value) {
+    size_t valueLen = strlen(value);
+    if (keyLen > CACHE_MAX_KEY_LEN || valueLen > UINT32_MAX - CacheEntrySize(keyLen, 0)) {
+        return false;
+    }
+    size_t entrySize = CacheEntrySize(keyLen, valueLen);
+    if (cache->maxBytes > 0 && entrySize > cache->maxBytes) {
+        return false;
+    }
+    // allocated before touching the cache, so running out of memory
+    // leaves the previous value in place
+    CacheEntry* entry = malloc(entrySize);
+    if (entry == NULL) {
+        return false;
+    }
+    entry->hash = hash;
+    entry->keyLen = keyLen;
+    entry->valueLen = valueLen;
+    memcpy(entry->data, key, keyLen + 1);
+    memcpy(entry->data + keyLen + 1, value, valueLen + 1);
+
+    CacheEntry** link = _cacheFindLink(cache, key, keyLen, hash);
+    if (*link != NULL) {
+        _cacheUnlinkEntry(cache, link);
+    } else if (cache->size >= cache->bucketCount && _cacheGrowIndex(cache)) {
+        // failing to grow only makes the chains longer
+        link = _cacheFindLink(cache, key, keyLen, hash);
+    }
+    entry->hashNext = *link;
+    *link = entry;
+    ListPushFront(&cache->recency, &entry->recency);
+    cache->size++;
+    cache->bytes += entrySize;
+
+    // the new entry is at the front and fits the limits on its own, so
+    // evicting from the back never reaches it
+    while (_cacheOverLimits(cache)) {
+        _cacheEvict(cache);
+    }
+    return true;
+}
+
+bool _cacheGetHashed(Cache* cache, const char* key, size_t keyLen, uint64_t hash, CacheView* view) {
+    CacheEntry* entry = *_cacheFindLink(cache, key, keyLen, hash);
+    if (entry == NULL) {
+        cache->misses++;
+        return false;
+    }
+    cache->hits++;
+    ListMoveToFront(&cache->recency, &entry->recency);
+    view->data = entry->data + entry->keyLen + 1;
+    view->len = entry->valueLen;
+    return true;
+}
+
+bool _cacheRemoveHashed(Cache* cache, const char* key, size_t keyLen, uint64_t hash) {
+    CacheEntry** link = _cacheFindLink(cache, key, keyLen, hash);
+    if (*link == NULL) {
+        return false;
+    }
+    _cacheUnlinkEntry(cache, link);
+    return true;
+}
+
+bool CachePut(Cache* cache, const char* key, const char* value) {
+    if (cache == NULL || key == NULL || value == NULL) {
+        return false;
+    }
+    size_t keyLen = strlen(key);
+    return _cachePutHashed(cache, key, keyLen, HashWy(key, keyLen, cache->seed), value);
+}
+
+bool CacheGet(Cache* cache, const char* key, CacheView* view) {
+    if (cache == NULL || key == NULL || view == NULL) {
+        return false;
+    }
+    size_t keyLen = strlen(key);
+    return _cacheGetHashed(cache, key, keyLen, HashWy(key, keyLen, cache->seed), view);
+}
+
+bool CacheRemove(Cache* cache, const char* key) {
+    if (cache == NULL || key == NULL) {
+        return false;
+    }
+    size_t keyLen = strlen(key);
+    return _cacheRemoveHashed(cache, key, keyLen, HashWy(key, keyLen, cache->seed));
+}
+
+// the index of each shard uses the low bits of the hash, the shard is
+// picked with the high ones so both spread the keys evenly
+CacheShard* _shardFor(ShardedCache* cache, uint64_t hash) {
+    return &cache->shards[(hash >> 56) & (cache->shardCount - 1)];
+}
+
+ShardedCache* CreateShardedCache(unsigned int shardCount, uint64_t maxEntries, uint64_t maxBytes) {
+    if (shardCount == 0 || shardCount > CACHE_MAX_SHARDS) {
+        return NULL;
+    }
+    unsigned int rounded = 1;
+    while (rounded < shardCount) {
+        rounded *= 2;
+    }
+    ShardedCache* cache = malloc(sizeof(ShardedCache));
+    if (cache == NULL) {
+        return NULL;
+    }
+    cache->shards = aligned_alloc(CACHE_LINE_SIZE, rounded * sizeof(CacheShard));
+    if (cache->shards == NULL) {
+        free(cache);
+        return NULL;
+    }
+    cache->shardCount = rounded;
+    cache->seed = RandomSeed();
+    // every shard shares the seed, so a key is hashed once for both lookups
+    uint64_t shardEntries = (maxEntries + rounded - 1) / rounded;
+    uint64_t shardBytes = (maxBytes + rounded - 1) / rounded;
+    unsigned int i;
+    for (i = 0; i < rounded; i++) {
+        cache->shards[i].cache = _createCacheWithSeed(shardEntries, shardBytes, cache->seed);
+        if (cache->shards[i].cache == NULL) {
+            cache->shardCount = i;
+            DestroyShardedCache(&cache);
+            return NULL;
+        }
+        pthread_mutex_init(&cache->shards[i].lock, NULL);
+    }
+    return cache;
+}
+
+void DestroyShardedCache(ShardedCache** cacheP) {
+    if (cacheP == NULL || *cacheP == NULL) {
+        return;
+    }
+    ShardedCache* cache = *cacheP;
+    unsigned int i;
+    for (i = 0; i < cache->shardCount; i++) {
+        pthread_mutex_destroy(&cache->shards[i].lock);
+        DestroyCache(&cache->shards[i].cache);
+    }
+    free(cache->shards);
+    free(cache);
+    *cacheP = NULL;
+}
+
+void SetShardedEvictionCallback(ShardedCache* cache, EvictionCallback onEvict, void* context) {
+    unsigned int i;
+    for (i = 0; i < cache->shardCount; i++) {
+        pthread_mutex_lock(&cache->shards[i].lock);
+        SetEvictionCallback(cache->shards[i].cache, onEvict, context);
+        pthread_mutex_unlock(&cache->shards[i].lock);
+    }
+}
+
+bool ShardedCachePut(ShardedCache* cache, const char* key, const char* value) {
+    if (cache == NULL || key == NULL || value == NULL) {
+        return false;
+    }
+    size_t keyLen = strlen(key);
+    uint64_t hash = HashWy(key, keyLen, cache->seed);
+    CacheShard* shard = _shardFor(cache, hash);
+    pthread_mutex_lock(&shard->lock);
+    bool stored = _cachePutHashed(shard->cache, key, keyLen, hash, value);
+    pthread_mutex_unlock(&shard->lock);
+    return stored;
+}
+
+bool ShardedCacheGet(ShardedCache* cache, const char* key, char* buffer, size_t bufferLen, size_t* valueLen) {
+    if (cache == NULL || key == NULL || (buffer == NULL && bufferLen > 0)) {
+        return false;
+    }
+    size_t keyLen = strlen(key);
+    uint64_t hash = HashWy(key, keyLen, cache->seed);
+    CacheShard* shard = _shardFor(cache, hash);
+    CacheView view;
+    pthread_mutex_lock(&shard->lock);
+    bool found = _cacheGetHashed(shard->cache, key, keyLen, hash, &view);
+    if (found) {
+        if (bufferLen > 0) {
+            size_t copied = view.len < bufferLen - 1 ? view.len : bufferLen - 1;
+            memcpy(buffer, view.data, copied);
+            buffer[copied] = '\0';
+        }
+        if (valueLen != NULL) {
+            *valueLen = view.len;
+        }
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return found;
+}
+
+bool ShardedCacheRemove(ShardedCache* cache, const char* key) {
+    if (cache == NULL || key == NULL) {
+        return false;
+    }
+    size_t keyLen = strlen(key);
+    uint64_t hash = HashWy(key, keyLen, cache->seed);
+    CacheShard* shard = _shardFor(cache, hash);
+    pthread_mutex_lock(&shard->lock);
+    bool removed = _cacheRemoveHashed(shard->cache, key, keyLen, hash);
+    pthread_mutex_unlock(&shard->lock);
+    return removed;
+}
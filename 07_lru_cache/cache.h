@@ -0,0 +1,103 @@
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "hash_functions.h"
+#include "intrusive_list.h"
+
+#define CACHE_INITIAL_BUCKETS 16
+#define CACHE_MAX_KEY_LEN UINT16_MAX
+#define CACHE_MAX_SHARDS 256
+#define CACHE_LINE_SIZE 64
+
+// called with the key and value of every entry the cache drops to make
+// room. Entries replaced by a Put, removed, or freed with the cache are
+// not evictions. The strings are only valid during the call
+typedef void (*EvictionCallback)(const char* key, uint32_t keyLen, const char* value, uint32_t valueLen, void* context);
+
+// key and value live right after the entry, in the same allocation.
+// recency chains the entries from the most to the least recently used,
+// hashNext chains the ones in the same bucket of the index
+typedef struct CacheEntry_T {
+    ListLink recency;
+    struct CacheEntry_T* hashNext;
+    uint64_t hash;
+    uint16_t keyLen;
+    uint32_t valueLen;
+    char data[];
+} CacheEntry;
+
+// a borrowed view of a cached value, valid until the next Put or Remove
+typedef struct {
+    const char* data;
+    uint32_t len;
+} CacheView;
+
+// a least recently used cache. Either limit can be 0 for no limit: maxEntries
+// counts entries, maxBytes counts the memory the entries take, headers included
+typedef struct {
+    CacheEntry** buckets;
+    uint32_t bucketCount;
+    uint32_t size;
+    IntrusiveList recency;
+    uint64_t maxEntries;
+    uint64_t maxBytes;
+    uint64_t bytes;
+    uint64_t seed;
+    EvictionCallback onEvict;
+    void* evictContext;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+} Cache;
+
+Cache* CreateCache(uint64_t maxEntries, uint64_t maxBytes);
+void DestroyCache(Cache** cacheP);
+void SetEvictionCallback(Cache* cache, EvictionCallback onEvict, void* context);
+// stores a copy of key and value as the most recently used entry, evicting
+// the least recently used ones until the limits hold again. False when the
+// entry alone is over maxBytes, or memory runs out
+bool CachePut(Cache* cache, const char* key, const char* value);
+// a hit makes the entry the most recently used
+bool CacheGet(Cache* cache, const char* key, CacheView* view);
+bool CacheRemove(Cache* cache, const char* key);
+size_t CacheEntrySize(size_t keyLen, size_t valueLen);
+
+// a cache split into shards, each one its own Cache behind its own mutex,
+// so threads touching different shards do not wait for each other. Keys
+// go to a shard by their hash, and each shard gets an equal part of the
+// limits, so the cache as a whole evicts only approximately in LRU order
+typedef struct {
+    pthread_mutex_t lock;
+    Cache* cache;
+} __attribute__((aligned(CACHE_LINE_SIZE))) CacheShard;
+
+typedef struct {
+    unsigned int shardCount;
+    uint64_t seed;
+    CacheShard* shards;
+} ShardedCache;
+
+// shardCount is rounded up to a power of two. The eviction callback runs
+// while its shard is locked, so it must not call back into the cache
+ShardedCache* CreateShardedCache(unsigned int shardCount, uint64_t maxEntries, uint64_t maxBytes);
+void DestroyShardedCache(ShardedCache** cacheP);
+void SetShardedEvictionCallback(ShardedCache* cache, EvictionCallback onEvict, void* context);
+bool ShardedCachePut(ShardedCache* cache, const char* key, const char* value);
+// views would not survive other threads, so the value is copied like
+// GetInto does in chapter 05: at most bufferLen - 1 bytes plus a terminator,
+// and valueLen always receives the full length
+bool ShardedCacheGet(ShardedCache* cache, const char* key, char* buffer, size_t bufferLen, size_t* valueLen);
+bool ShardedCacheRemove(ShardedCache* cache, const char* key);
+
+Cache* _createCacheWithSeed(uint64_t maxEntries, uint64_t maxBytes, uint64_t seed);
+CacheEntry** _cacheFindLink(Cache* cache, const char* key, size_t keyLen, uint64_t hash);
+bool _cacheGrowIndex(Cache* cache);
+void _cacheUnlinkEntry(Cache* cache, CacheEntry** link);
+bool _cacheOverLimits(Cache* cache);
+void _cacheEvict(Cache* cache);
+bool _cachePutHashed(Cache* cache, const char* key, size_t keyLen, uint64_t hash, const char* value);
+bool _cacheGetHashed(Cache* cache, const char* key, size_t keyLen, uint64_t hash, CacheView* view);
+bool _cacheRemoveHashed(Cache* cache, const char* key, size_t keyLen, uint64_t hash);
+CacheShard* _shardFor(ShardedCache* cache, uint64_t hash);
@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include "cache.h"
+
+#define THREADS 4
+#define KEYS_PER_THREAD 20000
+
+typedef struct {
+    char keys[16][32];
+    unsigned int count;
+} Evicted;
+
+void _recordEviction(const char* key, uint32_t keyLen, const char* value, uint32_t valueLen, void* context) {
+    Evicted* evicted = context;
+    assert(strlen(key) == keyLen && strlen(value) == valueLen);
+    strcpy(evicted->keys[evicted->count++], key);
+}
+
+bool _hasValue(Cache* cache, const char* key, const char* value) {
+    CacheView view;
+    return CacheGet(cache, key, &view) && view.len == strlen(value) && memcmp(view.data, value, view.len) == 0;
+}
+
+void TestPutGetRemove() {
+    Cache* cache = CreateCache(0, 0);
+    CacheView view;
+    assert(CacheGet(cache, "missing", &view) == false);
+    assert(CachePut(cache, "alpha", "1") == true);
+    assert(CachePut(cache, "beta", "") == true);
+    assert(_hasValue(cache, "alpha", "1"));
+    assert(_hasValue(cache, "beta", ""));
+    assert(CachePut(cache, "alpha", "a longer value") == true);
+    assert(_hasValue(cache, "alpha", "a longer value"));
+    assert(cache->size == 2);
+    assert(cache->bytes == CacheEntrySize(5, 14) + CacheEntrySize(4, 0));
+    assert(CacheRemove(cache, "alpha") == true);
+    assert(CacheRemove(cache, "alpha") == false);
+    assert(cache->size == 1 && cache->hits == 3 && cache->misses == 1);
+
+    // enough keys to grow the index a few times
+    char key[32], value[32];
+    int i;
+    for (i = 0; i < 10000; i++) {
+        sprintf(key, "key_%d", i);
+        sprintf(value, "value_%d", i);
+        assert(CachePut(cache, key, value) == true);
+    }
+    assert(cache->bucketCount >= 10000);
+    for (i = 0; i < 10000; i++) {
+        sprintf(key, "key_%d", i);
+        sprintf(value, "value_%d", i);
+        assert(_hasValue(cache, key, value));
+    }
+    DestroyCache(&cache);
+    assert(cache == NULL);
+    printf("Testing put, get and remove: PASS\n");
+}
+
+void TestEvictsLeastRecentlyUsed() {
+    Evicted evicted = { .count = 0 };
+    Cache* cache = CreateCache(3, 0);
+    SetEvictionCallback(cache, _recordEviction, &evicted);
+    CachePut(cache, "a", "1");
+    CachePut(cache, "b", "2");
+    CachePut(cache, "c", "3");
+    // reading a makes b the least recently used
+    assert(_hasValue(cache, "a", "1"));
+    CachePut(cache, "d", "4");
+    assert(evicted.count == 1 && strcmp(evicted.keys[0], "b") == 0);
+    CacheView view;
+    assert(CacheGet(cache, "b", &view) == false);
+
+    // replacing a value also counts as a use, and is not an eviction
+    CachePut(cache, "c", "33");
+    CachePut(cache, "e", "5");
+    assert(evicted.count == 2 && strcmp(evicted.keys[1], "a") == 0);
+    assert(cache->size == 3 && cache->evictions == 2);
+    assert(_hasValue(cache, "c", "33") && _hasValue(cache, "d", "4") && _hasValue(cache, "e", "5"));
+    DestroyCache(&cache);
+    printf("Testing the least recently used entry goes first: PASS\n");
+}
+
+void TestByteLimit() {
+    Evicted evicted = { .count = 0 };
+    uint64_t limit = CacheEntrySize(1, 10) * 3;
+    Cache* cache = CreateCache(0, limit);
+    SetEvictionCallback(cache, _recordEviction, &evicted);
+    CachePut(cache, "a", "0123456789");
+    CachePut(cache, "b", "0123456789");
+    CachePut(cache, "c", "0123456789");
+    assert(evicted.count == 0 && cache->bytes == limit);
+    // a bigger value pushes out as many entries as it needs
+    CachePut(cache, "d", "0123456789012345678901234567890123456789");
+    assert(cache->bytes <= limit);
+    assert(evicted.count == 2 && strcmp(evicted.keys[0], "a") == 0 && strcmp(evicted.keys[1], "b") == 0);
+
+    char huge[512];
+    memset(huge, 'x', sizeof(huge) - 1);
+    huge[sizeof(huge) - 1] = '\0';
+    assert(CachePut(cache, "huge", huge) == false);
+    assert(cache->size == 2 && evicted.count == 2);
+    DestroyCache(&cache);
+    printf("Testing the byte limit: PASS\n");
+}
+
+void* _shardedWorker(void* arg) {
+    ShardedCache* cache = ((void**)arg)[0];
+    long id = (long)((void**)arg)[1];
+    char key[32], value[32], buffer[32];
+    size_t valueLen;
+    int i;
+    for (i = 0; i < KEYS_PER_THREAD; i++) {
+        sprintf(key, "t%ld_%d", id, i);
+        sprintf(value, "v%d", i);
+        assert(ShardedCachePut(cache, key, value) == true);
+        // other threads may have evicted it already, but never mixed it up
+        if (ShardedCacheGet(cache, key, buffer, sizeof(buffer), &valueLen)) {
+            assert(strcmp(buffer, value) == 0 && valueLen == strlen(value));
+        }
+    }
+    return NULL;
+}
+
+void TestShardedCache() {
+    ShardedCache* cache = CreateShardedCache(6, 4096, 0);
+    assert(cache->shardCount == 8);
+    pthread_t threads[THREADS];
+    void* args[THREADS][2];
+    long i;
+    for (i = 0; i < THREADS; i++) {
+        args[i][0] = cache;
+        args[i][1] = (void*)i;
+        pthread_create(&threads[i], NULL, _shardedWorker, args[i]);
+    }
+    for (i = 0; i < THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    uint64_t total = 0;
+    for (i = 0; i < cache->shardCount; i++) {
+        assert(cache->shards[i].cache->size <= 4096 / 8);
+        total += cache->shards[i].cache->size;
+    }
+    assert(total > 0 && total <= 4096);
+
+    char buffer[4];
+    size_t valueLen;
+    assert(ShardedCachePut(cache, "long", "123456789") == true);
+    assert(ShardedCacheGet(cache, "long", buffer, sizeof(buffer), &valueLen) == true);
+    assert(strcmp(buffer, "123") == 0 && valueLen == 9);
+    assert(ShardedCacheRemove(cache, "long") == true);
+    assert(ShardedCacheGet(cache, "long", buffer, sizeof(buffer), &valueLen) == false);
+    DestroyShardedCache(&cache);
+    assert(cache == NULL);
+    assert(CreateShardedCache(0, 10, 0) == NULL);
+    printf("Testing the sharded cache from several threads: PASS\n");
+}
+
+int main(void) {
+    TestPutGetRemove();
+    TestEvictsLeastRecentlyUsed();
+    TestByteLimit();
+    TestShardedCache();
+    return 0;
+}
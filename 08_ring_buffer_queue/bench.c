@@ -0,0 +1,237 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include "ring_queue.h"
+
+#define TOTAL_ITEMS 4000000
+#define QUEUE_CAPACITY 1024
+#define ROUND_TRIPS 100000
+// after this many failed tries a thread gives its core away, without it a
+// single core machine would spin through whole time slices
+#define SPINS_BEFORE_YIELD 64
+
+double _nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// the baseline: the same ring with one mutex around it
+typedef struct {
+    pthread_mutex_t lock;
+    void** items;
+    size_t mask;
+    size_t head;
+    size_t tail;
+} LockedQueue;
+
+LockedQueue* _createLockedQueue(size_t capacity) {
+    LockedQueue* queue = malloc(sizeof(LockedQueue));
+    pthread_mutex_init(&queue->lock, NULL);
+    queue->items = malloc(capacity * sizeof(void*));
+    queue->mask = capacity - 1;
+    queue->head = 0;
+    queue->tail = 0;
+    return queue;
+}
+
+void _destroyLockedQueue(LockedQueue* queue) {
+    pthread_mutex_destroy(&queue->lock);
+    free(queue->items);
+    free(queue);
+}
+
+bool _lockedEnqueue(LockedQueue* queue, void* item) {
+    pthread_mutex_lock(&queue->lock);
+    bool stored = queue->tail - queue->head <= queue->mask;
+    if (stored) {
+        queue->items[queue->tail++ & queue->mask] = item;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return stored;
+}
+
+bool _lockedDequeue(LockedQueue* queue, void** item) {
+    pthread_mutex_lock(&queue->lock);
+    bool found = queue->head != queue->tail;
+    if (found) {
+        *item = queue->items[queue->head++ & queue->mask];
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return found;
+}
+
+typedef enum { KIND_MPMC, KIND_SPSC, KIND_LOCKED } QueueKind;
+
+static const char* kindNames[] = { "mpmc", "spsc", "mutex" };
+
+typedef struct {
+    QueueKind kind;
+    void* queue;
+} AnyQueue;
+
+bool _enqueue(AnyQueue* queue, void* item) {
+    switch (queue->kind) {
+    case KIND_MPMC: return MpmcEnqueue(queue->queue, item);
+    case KIND_SPSC: return SpscEnqueue(queue->queue, item);
+    default: return _lockedEnqueue(queue->queue, item);
+    }
+}
+
+bool _dequeue(AnyQueue* queue, void** item) {
+    switch (queue->kind) {
+    case KIND_MPMC: return MpmcDequeue(queue->queue, item);
+    case KIND_SPSC: return SpscDequeue(queue->queue, item);
+    default: return _lockedDequeue(queue->queue, item);
+    }
+}
+
+void _wait(unsigned int* spins) {
+    if (++*spins % SPINS_BEFORE_YIELD == 0) {
+        sched_yield();
+    }
+}
+
+AnyQueue _createQueue(QueueKind kind) {
+    AnyQueue queue = { kind, NULL };
+    if (kind == KIND_MPMC) queue.queue = CreateMpmcQueue(QUEUE_CAPACITY);
+    if (kind == KIND_SPSC) queue.queue = CreateSpscQueue(QUEUE_CAPACITY);
+    if (kind == KIND_LOCKED) queue.queue = _createLockedQueue(QUEUE_CAPACITY);
+    return queue;
+}
+
+void _destroyQueue(AnyQueue* queue) {
+    if (queue->kind == KIND_MPMC) DestroyMpmcQueue((MpmcQueue**)&queue->queue);
+    if (queue->kind == KIND_SPSC) DestroySpscQueue((SpscQueue**)&queue->queue);
+    if (queue->kind == KIND_LOCKED) _destroyLockedQueue(queue->queue);
+}
+
+typedef struct {
+    AnyQueue* queue;
+    uint64_t items;
+    pthread_t thread;
+} Worker;
+
+void* _producer(void* arg) {
+    Worker* worker = arg;
+    unsigned int spins = 0;
+    uint64_t i;
+    for (i = 1; i <= worker->items; i++) {
+        while (!_enqueue(worker->queue, (void*)(uintptr_t)i)) {
+            _wait(&spins);
+        }
+    }
+    return NULL;
+}
+
+void* _consumer(void* arg) {
+    Worker* worker = arg;
+    unsigned int spins = 0;
+    void* item;
+    uint64_t i;
+    for (i = 0; i < worker->items; i++) {
+        while (!_dequeue(worker->queue, &item)) {
+            _wait(&spins);
+        }
+    }
+    return NULL;
+}
+
+// every producer puts and every consumer takes an equal share of the items
+void _benchThroughput(QueueKind kind, unsigned int pairs) {
+    AnyQueue queue = _createQueue(kind);
+    Worker producers[16], consumers[16];
+    unsigned int i;
+    double start = _nowSeconds();
+    for (i = 0; i < pairs; i++) {
+        consumers[i].queue = &queue;
+        consumers[i].items = TOTAL_ITEMS / pairs;
+        pthread_create(&consumers[i].thread, NULL, _consumer, &consumers[i]);
+        producers[i].queue = &queue;
+        producers[i].items = TOTAL_ITEMS / pairs;
+        pthread_create(&producers[i].thread, NULL, _producer, &producers[i]);
+    }
+    for (i = 0; i < pairs; i++) {
+        pthread_join(producers[i].thread, NULL);
+        pthread_join(consumers[i].thread, NULL);
+    }
+    double elapsed = _nowSeconds() - start;
+    printf("  %-6s %2u producers %2u consumers   %7.2f M items/s\n", kindNames[kind], pairs, pairs,
+        (double)(TOTAL_ITEMS / pairs * pairs) / elapsed / 1e6);
+    _destroyQueue(&queue);
+}
+
+typedef struct {
+    AnyQueue* ping;
+    AnyQueue* pong;
+} Echo;
+
+void* _echo(void* arg) {
+    Echo* echo = arg;
+    unsigned int spins = 0;
+    void* item;
+    int i;
+    for (i = 0; i < ROUND_TRIPS; i++) {
+        while (!_dequeue(echo->ping, &item)) {
+            _wait(&spins);
+        }
+        while (!_enqueue(echo->pong, item)) {
+            _wait(&spins);
+        }
+    }
+    return NULL;
+}
+
+int _compareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// one item bounces between two threads through two queues
+void _benchLatency(QueueKind kind) {
+    AnyQueue ping = _createQueue(kind), pong = _createQueue(kind);
+    Echo echo = { &ping, &pong };
+    double* samples = malloc(ROUND_TRIPS * sizeof(double));
+    pthread_t thread;
+    pthread_create(&thread, NULL, _echo, &echo);
+    unsigned int spins = 0;
+    void* item;
+    int i;
+    for (i = 0; i < ROUND_TRIPS; i++) {
+        double start = _nowSeconds();
+        while (!_enqueue(&ping, (void*)1)) {
+            _wait(&spins);
+        }
+        while (!_dequeue(&pong, &item)) {
+            _wait(&spins);
+        }
+        samples[i] = (_nowSeconds() - start) * 1e9;
+    }
+    pthread_join(thread, NULL);
+    qsort(samples, ROUND_TRIPS, sizeof(double), _compareDoubles);
+    printf("  %-6s round trip   p50 %9.0f ns   p99 %9.0f ns\n", kindNames[kind],
+        samples[ROUND_TRIPS / 2], samples[ROUND_TRIPS * 99 / 100]);
+    free(samples);
+    _destroyQueue(&ping);
+    _destroyQueue(&pong);
+}
+
+int main(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    printf("throughput, %d items, capacity %d, %ld cores\n", TOTAL_ITEMS, QUEUE_CAPACITY, cores);
+    _benchThroughput(KIND_SPSC, 1);
+    unsigned int pairs;
+    for (pairs = 1; pairs <= 8; pairs *= 2) {
+        _benchThroughput(KIND_MPMC, pairs);
+        _benchThroughput(KIND_LOCKED, pairs);
+    }
+    printf("latency, %d round trips\n", ROUND_TRIPS);
+    _benchLatency(KIND_SPSC);
+    _benchLatency(KIND_MPMC);
+    _benchLatency(KIND_LOCKED);
+    return 0;
+}
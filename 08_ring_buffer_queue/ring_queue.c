@@ -0,0 +1,161 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "ring_queue.h"
+
+size_t _roundQueueCapacity(size_t capacity) {
+    if (capacity > SIZE_MAX / 2 + 1) {
+        return 0;
+    }
+    size_t rounded = RING_QUEUE_MIN_CAPACITY;
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+    return rounded;
+}
+
+MpmcQueue* CreateMpmcQueue(size_t capacity) {
+    capacity = _roundQueueCapacity(capacity);
+    if (capacity == 0 || capacity > SIZE_MAX / sizeof(RingSlot)) {
+        return NULL;
+    }
+    MpmcQueue* queue = aligned_alloc(CACHE_LINE_SIZE, sizeof(MpmcQueue));
+    if (queue == NULL) {
+        return NULL;
+    }
+    queue->slots = malloc(capacity * sizeof(RingSlot));
+    if (queue->slots == NULL) {
+        free(queue);
+        return NULL;
+    }
+    size_t i;
+    for (i = 0; i < capacity; i++) {
+        atomic_init(&queue->slots[i].sequence, i);
+        queue->slots[i].item = NULL;
+    }
+    queue->mask = capacity - 1;
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->head, 0);
+    return queue;
+}
+
+void DestroyMpmcQueue(MpmcQueue** queueP) {
+    if (queueP == NULL || *queueP == NULL) {
+        return;
+    }
+    free((*queueP)->slots);
+    free(*queueP);
+    *queueP = NULL;
+}
+
+bool MpmcEnqueue(MpmcQueue* queue, void* item) {
+    size_t position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    RingSlot* slot;
+    for (;;) {
+        slot = &queue->slots[position & queue->mask];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+        if (difference == 0) {
+            // the slot is free for this position, claim the position
+            if (atomic_compare_exchange_weak_explicit(&queue->tail, &position, position + 1,
+                memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+            // a failed exchange left the current tail in position
+        } else if (difference < 0) {
+            // the consumer of the previous lap has not read this slot yet
+            return false;
+        } else {
+            // another producer claimed this position first
+            position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+        }
+    }
+    slot->item = item;
+    // publishes the item to the consumer that will read this position
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+    return true;
+}
+
+bool MpmcDequeue(MpmcQueue* queue, void** item) {
+    size_t position = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    RingSlot* slot;
+    for (;;) {
+        slot = &queue->slots[position & queue->mask];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)(position + 1);
+        if (difference == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->head, &position, position + 1,
+                memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // no producer has written this position yet
+            return false;
+        } else {
+            position = atomic_load_explicit(&queue->head, memory_order_relaxed);
+        }
+    }
+    *item = slot->item;
+    // hands the slot to the producer of the next lap
+    atomic_store_explicit(&slot->sequence, position + queue->mask + 1, memory_order_release);
+    return true;
+}
+
+SpscQueue* CreateSpscQueue(size_t capacity) {
+    capacity = _roundQueueCapacity(capacity);
+    if (capacity == 0 || capacity > SIZE_MAX / sizeof(void*)) {
+        return NULL;
+    }
+    SpscQueue* queue = aligned_alloc(CACHE_LINE_SIZE, sizeof(SpscQueue));
+    if (queue == NULL) {
+        return NULL;
+    }
+    queue->items = malloc(capacity * sizeof(void*));
+    if (queue->items == NULL) {
+        free(queue);
+        return NULL;
+    }
+    queue->mask = capacity - 1;
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->head, 0);
+    queue->cachedHead = 0;
+    queue->cachedTail = 0;
+    return queue;
+}
+
+void DestroySpscQueue(SpscQueue** queueP) {
+    if (queueP == NULL || *queueP == NULL) {
+        return;
+    }
+    free((*queueP)->items);
+    free(*queueP);
+    *queueP = NULL;
+}
+
+bool SpscEnqueue(SpscQueue* queue, void* item) {
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    if (tail - queue->cachedHead > queue->mask) {
+        // looks full, find out how far the consumer really is
+        queue->cachedHead = atomic_load_explicit(&queue->head, memory_order_acquire);
+        if (tail - queue->cachedHead > queue->mask) {
+            return false;
+        }
+    }
+    queue->items[tail & queue->mask] = item;
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+bool SpscDequeue(SpscQueue* queue, void** item) {
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    if (head == queue->cachedTail) {
+        queue->cachedTail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        if (head == queue->cachedTail) {
+            return false;
+        }
+    }
+    *item = queue->items[head & queue->mask];
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    return true;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#define CACHE_LINE_SIZE 64
+#define RING_QUEUE_MIN_CAPACITY 2
+
+// every slot carries a sequence number that tells whose turn it is:
+// sequence == position means a producer at that position may write it,
+// sequence == position + 1 means a consumer at that position may read it.
+// After reading, the consumer sets it to position + capacity, the position
+// that will use the slot on the next lap
+typedef struct {
+    _Atomic size_t sequence;
+    void* item;
+} RingSlot;
+
+// a bounded multi producer, multi consumer queue over a flat array, after
+// Dmitry Vyukov's design. Producers claim positions from tail and consumers
+// from head, each with a single compare and swap and no locks. head and tail
+// sit on their own cache lines, so producers and consumers do not keep
+// stealing each other's line
+typedef struct {
+    _Alignas(CACHE_LINE_SIZE) _Atomic size_t tail;
+    _Alignas(CACHE_LINE_SIZE) _Atomic size_t head;
+    _Alignas(CACHE_LINE_SIZE) size_t mask;
+    RingSlot* slots;
+} MpmcQueue;
+
+// capacity is rounded up to a power of two, so a position becomes a slot
+// with a mask instead of a division
+MpmcQueue* CreateMpmcQueue(size_t capacity);
+void DestroyMpmcQueue(MpmcQueue** queueP);
+// false when the queue is full
+bool MpmcEnqueue(MpmcQueue* queue, void* item);
+// false when the queue is empty
+bool MpmcDequeue(MpmcQueue* queue, void** item);
+
+// the fast path for exactly one producer thread and one consumer thread:
+// each side owns its index, so no compare and swap is needed, and keeps a
+// copy of the other side's index that it only refreshes when the queue
+// looks full or empty
+typedef struct {
+    _Alignas(CACHE_LINE_SIZE) _Atomic size_t tail;
+    size_t cachedHead;
+    _Alignas(CACHE_LINE_SIZE) _Atomic size_t head;
+    size_t cachedTail;
+    _Alignas(CACHE_LINE_SIZE) size_t mask;
+    void** items;
+} SpscQueue;
+
+SpscQueue* CreateSpscQueue(size_t capacity);
+void DestroySpscQueue(SpscQueue** queueP);
+// only ever called from the producer thread
+bool SpscEnqueue(SpscQueue* queue, void* item);
+// only ever called from the consumer thread
+bool SpscDequeue(SpscQueue* queue, void** item);
+
+size_t _roundQueueCapacity(size_t capacity);
@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include "ring_queue.h"
+
+#define PRODUCERS 3
+#define CONSUMERS 3
+#define ITEMS_PER_PRODUCER 100000
+
+// items are (producer << 32 | sequence) + 1, so none of them is NULL
+#define MAKE_ITEM(producer, sequence) ((void*)(uintptr_t)((((uint64_t)(producer) << 32) | (sequence)) + 1))
+#define ITEM_PRODUCER(item) ((((uint64_t)(uintptr_t)(item)) - 1) >> 32)
+#define ITEM_SEQUENCE(item) ((((uint64_t)(uintptr_t)(item)) - 1) & 0xFFFFFFFF)
+
+void TestMpmcSingleThread() {
+    MpmcQueue* queue = CreateMpmcQueue(5);
+    assert(queue->mask + 1 == 8);
+    void* item;
+    assert(MpmcDequeue(queue, &item) == false);
+    uintptr_t i;
+    // a few laps around the ring
+    for (i = 0; i < 100; i++) {
+        assert(MpmcEnqueue(queue, (void*)(i + 1)) == true);
+        if (i % 3 == 2) {
+            assert(MpmcDequeue(queue, &item) == true);
+        }
+        if (queue->tail - queue->head == 8) {
+            assert(MpmcEnqueue(queue, (void*)1) == false);
+            break;
+        }
+    }
+    uintptr_t expected = atomic_load(&queue->head) + 1;
+    while (MpmcDequeue(queue, &item)) {
+        assert((uintptr_t)item == expected++);
+    }
+    assert(atomic_load(&queue->head) == atomic_load(&queue->tail));
+    DestroyMpmcQueue(&queue);
+    assert(queue == NULL);
+    assert(CreateMpmcQueue(SIZE_MAX) == NULL);
+    printf("Testing the MPMC queue on one thread: PASS\n");
+}
+
+typedef struct {
+    MpmcQueue* queue;
+    unsigned int id;
+    // per consumer, the last sequence seen from each producer
+    int64_t lastSeen[PRODUCERS];
+    uint64_t received;
+    uint64_t* counts;
+} Worker;
+
+_Atomic int producersDone;
+
+void* _producer(void* arg) {
+    Worker* worker = arg;
+    uint32_t i;
+    for (i = 0; i < ITEMS_PER_PRODUCER; i++) {
+        while (!MpmcEnqueue(worker->queue, MAKE_ITEM(worker->id, i))) {
+            sched_yield();
+        }
+    }
+    atomic_fetch_add(&producersDone, 1);
+    return NULL;
+}
+
+void* _consumer(void* arg) {
+    Worker* worker = arg;
+    void* item;
+    for (;;) {
+        if (!MpmcDequeue(worker->queue, &item)) {
+            if (atomic_load(&producersDone) == PRODUCERS && !MpmcDequeue(worker->queue, &item)) {
+                return NULL;
+            }
+            sched_yield();
+            continue;
+        }
+        uint64_t producer = ITEM_PRODUCER(item);
+        int64_t sequence = ITEM_SEQUENCE(item);
+        assert(producer < PRODUCERS);
+        // items of one producer come out in the order it put them in
+        assert(sequence > worker->lastSeen[producer]);
+        worker->lastSeen[producer] = sequence;
+        __atomic_fetch_add(&worker->counts[producer * ITEMS_PER_PRODUCER + sequence], 1, __ATOMIC_RELAXED);
+        worker->received++;
+    }
+}
+
+void TestMpmcManyThreads() {
+    MpmcQueue* queue = CreateMpmcQueue(64);
+    uint64_t* counts = calloc(PRODUCERS * ITEMS_PER_PRODUCER, sizeof(uint64_t));
+    Worker producers[PRODUCERS], consumers[CONSUMERS];
+    pthread_t threads[PRODUCERS + CONSUMERS];
+    unsigned int i, j;
+    atomic_store(&producersDone, 0);
+    for (i = 0; i < CONSUMERS; i++) {
+        consumers[i].queue = queue;
+        consumers[i].received = 0;
+        consumers[i].counts = counts;
+        for (j = 0; j < PRODUCERS; j++) {
+            consumers[i].lastSeen[j] = -1;
+        }
+        pthread_create(&threads[PRODUCERS + i], NULL, _consumer, &consumers[i]);
+    }
+    for (i = 0; i < PRODUCERS; i++) {
+        producers[i].queue = queue;
+        producers[i].id = i;
+        pthread_create(&threads[i], NULL, _producer, &producers[i]);
+    }
+    for (i = 0; i < PRODUCERS + CONSUMERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    uint64_t received = 0;
+    for (i = 0; i < CONSUMERS; i++) {
+        received += consumers[i].received;
+    }
+    assert(received == (uint64_t)PRODUCERS * ITEMS_PER_PRODUCER);
+    // every item came out exactly once
+    for (i = 0; i < PRODUCERS * ITEMS_PER_PRODUCER; i++) {
+        assert(counts[i] == 1);
+    }
+    free(counts);
+    DestroyMpmcQueue(&queue);
+    printf("Testing the MPMC queue with %d producers and %d consumers: PASS\n", PRODUCERS, CONSUMERS);
+}
+
+void* _spscProducer(void* arg) {
+    SpscQueue* queue = arg;
+    uintptr_t i;
+    for (i = 1; i <= ITEMS_PER_PRODUCER; i++) {
+        while (!SpscEnqueue(queue, (void*)i)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+void TestSpsc() {
+    SpscQueue* queue = CreateSpscQueue(4);
+    void* item;
+    assert(SpscDequeue(queue, &item) == false);
+    uintptr_t i;
+    for (i = 1; i <= 4; i++) {
+        assert(SpscEnqueue(queue, (void*)i) == true);
+    }
+    assert(SpscEnqueue(queue, (void*)5) == false);
+    assert(SpscDequeue(queue, &item) == true && (uintptr_t)item == 1);
+    assert(SpscEnqueue(queue, (void*)5) == true);
+    for (i = 2; i <= 5; i++) {
+        assert(SpscDequeue(queue, &item) == true && (uintptr_t)item == i);
+    }
+    assert(SpscDequeue(queue, &item) == false);
+    DestroySpscQueue(&queue);
+
+    queue = CreateSpscQueue(16);
+    pthread_t producer;
+    pthread_create(&producer, NULL, _spscProducer, queue);
+    uintptr_t expected = 1;
+    while (expected <= ITEMS_PER_PRODUCER) {
+        if (SpscDequeue(queue, &item)) {
+            assert((uintptr_t)item == expected);
+            expected++;
+        } else {
+            sched_yield();
+        }
+    }
+    pthread_join(producer, NULL);
+    DestroySpscQueue(&queue);
+    assert(queue == NULL);
+    printf("Testing the SPSC queue: PASS\n");
+}
+
+int main(void) {
+    TestMpmcSingleThread();
+    TestMpmcManyThreads();
+    TestSpsc();
+    return 0;
+}
@@ -0,0 +1,22 @@
+#include <stdio.h>
+#include <stdarg.h>
+#include "log.h"
+
+static LogHook logHook = NULL;
+
+void SetLogHook(LogHook hook) {
+    logHook = hook;
+}
+
+void _logMessage(const char* format, ...) {
+    char message[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    if (logHook != NULL) {
+        logHook(message);
+        return;
+    }
+    fprintf(stderr, "%s\n", message);
+}
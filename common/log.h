@@ -0,0 +1,16 @@
+#pragma once
+
+// the libraries do no I/O unless they are built with -DLIBRARY_LOGGING,
+// then every message goes to the hook set with SetLogHook,
+// or to stderr when no hook was set
+#ifdef LIBRARY_LOGGING
+#define LOG(...) _logMessage(__VA_ARGS__)
+#else
+#define LOG(...) ((void)0)
+#endif
+
+typedef void (*LogHook)(const char* message);
+
+void SetLogHook(LogHook hook);
+
+void _logMessage(const char* format, ...);
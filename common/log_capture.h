@@ -0,0 +1,10 @@
+#pragma once
+#include <stdio.h>
+#include "log.h"
+
+// for tests: a hook that keeps the last message so it can be asserted on
+static char lastMessage[256];
+
+static void _captureMessage(const char* message) {
+    snprintf(lastMessage, sizeof(lastMessage), "%s", message);
+}